@@ -1064,6 +1064,7 @@ public:
 	int		accuracy, stamina;		// [RH] Strife stats -- [XA] moved here for DECORATE/ACS access.
 
 	AActor			*inext, **iprev;// Links to other mobjs in same bucket
+	unsigned		ClassIndex;		// Position in Level->ActorsByClass
 	TObjPtr<AActor*> goal;			// Monster's goal if not chasing anything
 	int				waterlevel;		// 0=none, 1=feet, 2=waist, 3=eyes
 	uint8_t			boomwaterlevel;	// splash information for non-swimmable water sectors
@@ -1188,7 +1189,9 @@ private:
 	void AddToHash ();
 	void RemoveFromHash ();
 
-	static inline int TIDHASH (int key) { return key & 127; }
+public:
+	void AddToClassIndex ();
+	void RemoveFromClassIndex ();
 
 public:
 	static FSharedStringArena mStringPropertyData;
@@ -1444,14 +1447,58 @@ public:
 	DVector3 (*AttackDir)(AActor* actor, DAngle yaw, DAngle pitch);
 };
 
+//==========================================================================
+//
+// TID hash
+//
+// Actors with a TID are chained through inext/iprev. The bucket count
+// doubles when the chains get too long so that lookups stay cheap even
+// if a map tags thousands of actors.
+//
+//==========================================================================
+
+struct FTIDHash
+{
+	enum
+	{
+		MINBITS = 7,
+		MAXLOAD = 2,	// average chain length that triggers a resize
+	};
+
+	FTIDHash() { Clear(); }
+
+	void Clear()
+	{
+		Buckets.Resize(1 << MINBITS);
+		memset(Buckets.Data(), 0, Buckets.Size() * sizeof(AActor*));
+		Shift = 32 - MINBITS;
+		Count = 0;
+	}
+
+	AActor *&Bucket(int tid)
+	{
+		return Buckets[(uint32_t(tid) * 2654435769u) >> Shift];
+	}
+
+	void Link(AActor *actor);
+	void Unlink(AActor *actor);
+
+private:
+	void Grow();
+
+	TArray<AActor *> Buckets;
+	unsigned Shift;
+	unsigned Count;
+};
+
 class FActorIterator
 {
 	friend struct FLevelLocals;
 protected:
-	FActorIterator (AActor **hash, int i) : TIDHash(hash), base (nullptr), id (i)
+	FActorIterator (FTIDHash &hash, int i) : TIDHash(&hash), base (nullptr), id (i)
 	{
 	}
-	FActorIterator (AActor **hash, int i, AActor *start) : TIDHash(hash), base (start), id (i)
+	FActorIterator (FTIDHash &hash, int i, AActor *start) : TIDHash(&hash), base (start), id (i)
 	{
 	}
 public:
@@ -1460,7 +1507,7 @@ public:
 		if (id == 0)
 			return nullptr;
 		if (!base)
-			base = TIDHash[id & 127];
+			base = TIDHash->Bucket(id);
 		else
 			base = base->inext;
 
@@ -1475,7 +1522,7 @@ public:
 	}
 
 private:
-	AActor **TIDHash;
+	FTIDHash *TIDHash;
 	AActor *base;
 	int id;
 };
@@ -1485,8 +1532,8 @@ class NActorIterator : public FActorIterator
 	friend struct FLevelLocals;
 	const PClass *type;
 protected:
-	NActorIterator (AActor **hash, const PClass *cls, int id) : FActorIterator (hash, id) { type = cls; }
-	NActorIterator (AActor **hash, FName cls, int id) : FActorIterator (hash, id) { type = PClass::FindClass(cls); }
+	NActorIterator (FTIDHash &hash, const PClass *cls, int id) : FActorIterator (hash, id) { type = cls; }
+	NActorIterator (FTIDHash &hash, FName cls, int id) : FActorIterator (hash, id) { type = PClass::FindClass(cls); }
 public:
 	AActor *Next ()
 	{
@@ -890,6 +890,129 @@ void AM_StaticInit()
 
 IMPLEMENT_CLASS(DAutomapBase, true, false);
 
+//=============================================================================
+//
+// FAutomapGrid
+//
+// Coarse grid of map elements, used to find everything that may be inside
+// the automap window without having to check the entire map every frame.
+//
+//=============================================================================
+
+class FAutomapGrid
+{
+	enum { CellSize = 512 };
+
+	double OriginX = 0, OriginY = 0;
+	int Width = 0, Height = 0;
+	TArray<unsigned> CellStart;		// Width * Height + 1 offsets into Items
+	TArray<int> Items;
+	TArray<int> Stamps;
+	int Stamp = 0;
+
+	void GetCells(const FBoundingBox &box, int &x1, int &y1, int &x2, int &y2) const
+	{
+		x1 = clamp(int((box.Left() - OriginX) / CellSize), 0, Width - 1);
+		x2 = clamp(int((box.Right() - OriginX) / CellSize), 0, Width - 1);
+		y1 = clamp(int((box.Bottom() - OriginY) / CellSize), 0, Height - 1);
+		y2 = clamp(int((box.Top() - OriginY) / CellSize), 0, Height - 1);
+	}
+
+public:
+	bool IsBuilt() const
+	{
+		return CellStart.Size() > 0;
+	}
+
+	// Elements with an empty box are left out.
+	void Build(const TArray<FBoundingBox> &boxes)
+	{
+		double maxx = -FLT_MAX, maxy = -FLT_MAX;
+		OriginX = OriginY = FLT_MAX;
+		for (auto &box : boxes)
+		{
+			if (box.Left() > box.Right()) continue;
+			OriginX = MIN(OriginX, box.Left());
+			OriginY = MIN(OriginY, box.Bottom());
+			maxx = MAX(maxx, box.Right());
+			maxy = MAX(maxy, box.Top());
+		}
+		if (maxx < OriginX)
+		{
+			OriginX = OriginY = maxx = maxy = 0;
+		}
+		Width = int((maxx - OriginX) / CellSize) + 1;
+		Height = int((maxy - OriginY) / CellSize) + 1;
+
+		// Count the elements per cell first so that they can be stored in one array.
+		CellStart.Resize(Width * Height + 1);
+		memset(CellStart.Data(), 0, CellStart.Size() * sizeof(unsigned));
+		for (int pass = 0; pass < 2; pass++)
+		{
+			for (unsigned i = 0; i < boxes.Size(); i++)
+			{
+				if (boxes[i].Left() > boxes[i].Right()) continue;
+				int x1, y1, x2, y2;
+				GetCells(boxes[i], x1, y1, x2, y2);
+				for (int y = y1; y <= y2; y++)
+				{
+					for (int x = x1; x <= x2; x++)
+					{
+						if (pass == 0) CellStart[y * Width + x + 1]++;
+						else Items[CellStart[y * Width + x]++] = i;
+					}
+				}
+			}
+			if (pass == 0)
+			{
+				for (int c = 0; c < Width * Height; c++) CellStart[c + 1] += CellStart[c];
+				Items.Resize(CellStart.Last());
+			}
+			else
+			{
+				// The fill pass moved every cell's start to the next one's.
+				for (int c = Width * Height; c > 0; c--) CellStart[c] = CellStart[c - 1];
+				CellStart[0] = 0;
+			}
+		}
+		Stamps.Resize(boxes.Size());
+		memset(Stamps.Data(), 0, Stamps.Size() * sizeof(int));
+		Stamp = 0;
+	}
+
+	// Returns all elements in the cells touched by the box, sorted by index
+	// so that they get drawn in the same order as before.
+	void Collect(const FBoundingBox &box, TArray<int> &result)
+	{
+		result.Clear();
+		if (box.Right() < OriginX || box.Top() < OriginY ||
+			box.Left() > OriginX + Width * CellSize || box.Bottom() > OriginY + Height * CellSize)
+		{
+			return;
+		}
+		Stamp++;
+		int x1, y1, x2, y2;
+		GetCells(box, x1, y1, x2, y2);
+		for (int y = y1; y <= y2; y++)
+		{
+			for (int x = x1; x <= x2; x++)
+			{
+				int c = y * Width + x;
+				for (unsigned i = CellStart[c]; i < CellStart[c + 1]; i++)
+				{
+					int item = Items[i];
+					if (Stamps[item] != Stamp)
+					{
+						Stamps[item] = Stamp;
+						result.Push(item);
+					}
+				}
+			}
+		}
+		std::sort(result.begin(), result.end());
+	}
+};
+
 class DAutomap :public DAutomapBase
 {
 	DECLARE_CLASS(DAutomap, DAutomapBase)
@@ -965,6 +1088,12 @@ class DAutomap :public DAutomapBase
 
 	TArray<FVector2> points;
 
+	// for culling against the automap window. Built on first use.
+	FAutomapGrid LineGrid;
+	FAutomapGrid SubsectorGrid;
+	TArray<int> PolyLines;		// these can move so they are not in the grid.
+	TArray<int> VisibleItems;
+
 	// translates between frame-buffer and map distances
 	double FTOM(double x)
 	{
@@ -992,6 +1121,8 @@ class DAutomap :public DAutomapBase
 	void DrawMarker(FTexture *tex, double x, double y, int yadjust,
 		INTBOOL flip, double xscale, double yscale, int translation, double alpha, uint32_t fillcolor, FRenderStyle renderstyle);
 
+	void buildGrids();
+	FBoundingBox getVisibleBox(const DVector2 &offset);
 	void rotatePoint(double *x, double *y);
 	void rotate(double *x, double *y, DAngle an);
 	void doFollowPlayer();
@@ -1360,6 +1491,7 @@ void DAutomap::LevelInit ()
 	clearMarks();
 
 	findMinMaxBoundaries();
+	buildGrids();
 	scale_mtof = min_scale_mtof / 0.7;
 	if (scale_mtof > max_scale_mtof)
 		scale_mtof = min_scale_mtof;
@@ -1952,6 +2084,65 @@ sector_t * AM_FakeFlat(AActor *viewer, sector_t * sec, sector_t * dest)
 //
 //=============================================================================
 
+void DAutomap::buildGrids()
+{
+	TArray<FBoundingBox> boxes;
+
+	PolyLines.Clear();
+	boxes.Resize(Level->lines.Size());
+	for (unsigned i = 0; i < Level->lines.Size(); i++)
+	{
+		auto &line = Level->lines[i];
+		if (line.sidedef[0]->Flags & WALLF_POLYOBJ)
+		{
+			PolyLines.Push(i);
+			boxes[i].ClearBox();
+		}
+		else
+		{
+			boxes[i] = FBoundingBox(line.bbox[BOXLEFT], line.bbox[BOXBOTTOM], line.bbox[BOXRIGHT], line.bbox[BOXTOP]);
+		}
+	}
+	LineGrid.Build(boxes);
+
+	boxes.Resize(Level->subsectors.Size());
+	for (unsigned i = 0; i < Level->subsectors.Size(); i++)
+	{
+		auto sub = &Level->subsectors[i];
+		boxes[i].ClearBox();
+		if (sub->flags & SSECF_POLYORG) continue;
+		for (uint32_t j = 0; j < sub->numlines; j++)
+		{
+			boxes[i].AddToBox(sub->firstline[j].v1->fPos());
+		}
+	}
+	SubsectorGrid.Build(boxes);
+}
+
+//=============================================================================
+//
+// Returns the area of the map that may be visible in the automap window,
+// for elements displaced by the given portal offset.
+//
+//=============================================================================
+
+FBoundingBox DAutomap::getVisibleBox(const DVector2 &offset)
+{
+	if (am_rotate == 1 || (am_rotate == 2 && viewactive))
+	{
+		// The map gets rotated around the window's center so anything in the enclosing circle may be visible.
+		double radius = sqrt(m_w * m_w + m_h * m_h) / 2;
+		return FBoundingBox(m_x + m_w / 2 - offset.X, m_y + m_h / 2 - offset.Y, radius);
+	}
+	return FBoundingBox(m_x - offset.X, m_y - offset.Y, m_x2 - offset.X, m_y2 - offset.Y);
+}
+
+//=============================================================================
+//
+//
+//
+//=============================================================================
+
 void DAutomap::drawSubsectors()
 {
 	std::vector<uint32_t> indices;
@@ -1966,7 +2157,8 @@ void DAutomap::drawSubsectors()
 	mpoint_t originpt;
 
 	auto &subsectors = Level->subsectors;
-	for (unsigned i = 0; i < subsectors.Size(); ++i)
+	SubsectorGrid.Collect(getVisibleBox({ 0, 0 }), VisibleItems);
+	for (auto i : VisibleItems)
 	{
 		auto sub = &subsectors[i];
 		if (sub->flags & SSECF_POLYORG)
@@ -2481,9 +2673,17 @@ void DAutomap::drawWalls (bool allmap)
 	{
 		if (p == MapPortalGroup) continue;
 
+		DVector2 groupoffset = p >= 0 ? Level->Displacements.getOffset(p, MapPortalGroup) : DVector2(0, 0);
+		LineGrid.Collect(getVisibleBox(groupoffset), VisibleItems);
 
-		for (auto &line : Level->lines)
+		// Merge the polyobject lines back in so that everything gets drawn in line order, like without culling.
+		unsigned gridcount = VisibleItems.Size();
+		VisibleItems.Append(PolyLines);
+		std::inplace_merge(VisibleItems.begin(), VisibleItems.begin() + gridcount, VisibleItems.end());
+
+		for (auto index : VisibleItems)
 		{
+			auto &line = Level->lines[index];
 			int pg;
 			
 			if (line.sidedef[0]->Flags & WALLF_POLYOBJ)
@@ -2877,6 +3077,7 @@ void DAutomap::drawThings ()
 	AActor*	 t;
 	mpoint_t p;
 	DAngle	 angle;
+	FBoundingBox visible = getVisibleBox({ 0, 0 });
 
 	for (auto &sec : Level->sectors)
 	{
@@ -2889,6 +3090,16 @@ void DAutomap::drawThings ()
 				p.x = pos.X;
 				p.y = pos.Y;
 
+				// Leave enough room for the marker or sprite to reach into the window.
+				double margin = MAX(t->radius, 16.);
+				if (am_showthingsprites > 0) margin = MAX(margin, 256. * MAX(t->Scale.X, t->Scale.Y));
+				if (p.x + margin < visible.Left() || p.x - margin > visible.Right() ||
+					p.y + margin < visible.Bottom() || p.y - margin > visible.Top())
+				{
+					t = t->snext;
+					continue;
+				}
+
 				if (am_showthingsprites > 0 && t->sprite > 0)
 				{
 					FTexture *texture = nullptr;
@@ -3192,6 +3403,7 @@ void DAutomap::Drawer (int bottom)
 		f_h = viewheight;
 	}
 	activateNewScale();
+	if (!LineGrid.IsBuilt()) buildGrids();
 
 	if (am_textured && !viewactive)
 		drawSubsectors();
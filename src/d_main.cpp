@@ -103,6 +103,7 @@
 #include "g_cvars.h"
 #include "r_data/r_vanillatrans.h"
 #include <hwrenderer\utility\hw_vrmodes.h>
+#include "hwrenderer/textures/hw_ihwtexture.h"
 
 EXTERN_CVAR(Bool, hud_althud)
 EXTERN_CVAR(Int, vr_mode)
@@ -770,6 +771,8 @@ void D_Display ()
 	screen->FrameTime = I_msTimeFS();
 	TexMan.UpdateAnimations(screen->FrameTime);
 	R_UpdateSky(screen->FrameTime);
+	IHardwareTexture::EvictUnused();
+	IHardwareTexture::UpdateStreamedTextures();
 	screen->BeginFrame();
 	screen->ClearClipRect();
 	if ((gamestate == GS_LEVEL || gamestate == GS_TITLELEVEL) && gametic != 0)
@@ -1011,6 +1014,7 @@ void D_DoomLoop ()
 				lasttic = gametic;
 				I_StartFrame ();
 			}
+			G_CheckPendingSave ();
 			I_SetFrameTime();
 
 			// process one or more tics
@@ -3605,7 +3605,6 @@ void FParser::SF_MobjHeight(void)
 void FParser::SF_ThingCount(void)
 {
 	PClassActor *pClass;
-	AActor * mo;
 	int count=0;
 	bool replacemented = false;
 
@@ -3618,13 +3617,13 @@ void FParser::SF_ThingCount(void)
 		pClass = pClass->GetReplacement(Level);
 		
 	again:
-		auto it = Level->GetThinkerIterator<AActor>();
+		auto list = Level->GetActorsOfClass(pClass);
 
-		if (t_argc<2 || intvalue(t_argv[1])==0 || pClass->IsDescendantOf(NAME_Inventory))
+		if (list != nullptr)
 		{
-			while ((mo=it.Next()))
+			if (t_argc<2 || intvalue(t_argv[1])==0 || pClass->IsDescendantOf(NAME_Inventory))
 			{
-				if (mo->IsA(pClass))
+				for (auto mo : *list)
 				{
 					if (mo->IsMapActor())
 					{
@@ -3632,12 +3631,12 @@ void FParser::SF_ThingCount(void)
 					}
 				}
 			}
-		}
-		else
-		{
-			while ((mo=it.Next()))
+			else
 			{
-				if (mo->IsA(pClass) && mo->health>0) count++;
+				for (auto mo : *list)
+				{
+					if (mo->health>0) count++;
+				}
 			}
 		}
 		if (!replacemented)
@@ -178,6 +178,21 @@ static void add_char(char *tokn, char c)
 char *FParser::GetTokens(char *s)
 {
 	char *tokn = NULL;
+	int ofs = -1;
+
+	// only statements inside the script text itself can be cached.
+	// Includes are parsed from a temporary buffer.
+	if (s >= Script->data && s < Script->data + Script->len)
+	{
+		ofs = Script->MakeIndex(s);
+		int *index = Script->StatementIndex.CheckKey(ofs);
+		if (index != nullptr)
+		{
+			CurStatement = *index;
+			return RestoreTokens(Script->Statements[*index]);
+		}
+	}
+	CurStatement = -1;
 
 	Rover = s;
 	NumTokens = 1;
@@ -280,6 +295,66 @@ char *FParser::GetTokens(char *s)
 	}
 	
 	Rover++;
+	if (ofs >= 0) CacheTokens(ofs);
+	return Rover;
+}
+
+//==========================================================================
+//
+// CacheTokens: remember the statement that was just tokenized
+//
+//==========================================================================
+
+void FParser::CacheTokens(int ofs)
+{
+	unsigned index = Script->Statements.Reserve(1);
+	FsStatement &st = Script->Statements[index];
+	size_t textlen = NumTokens > 0 ? Tokens[NumTokens-1] - Tokens[0] + strlen(Tokens[NumTokens-1]) + 1 : 1;
+
+	st.TokenText.Resize((unsigned)textlen);
+	memcpy(st.TokenText.Data(), Tokens[0], textlen);
+	st.TokenOfs.Resize(NumTokens);
+	st.TokenTypes.Resize(NumTokens);
+	for (int i = 0; i < NumTokens; i++)
+	{
+		st.TokenOfs[i] = int(Tokens[i] - Tokens[0]);
+		st.TokenTypes[i] = TokenType[i];
+	}
+	st.LineStart = Script->MakeIndex(LineStart);
+	st.End = Script->MakeIndex(Rover);
+	st.HasSection = Section != nullptr;
+	st.BraceType = BraceType;
+	st.Plans.Clear();
+
+	Script->StatementIndex[ofs] = index;
+	CurStatement = index;
+}
+
+//==========================================================================
+//
+// RestoreTokens: set up the parser state from a cached statement
+// exactly as GetTokens would have left it.
+//
+//==========================================================================
+
+char *FParser::RestoreTokens(const FsStatement &st)
+{
+	NumTokens = st.TokenOfs.Size();
+	memcpy(Tokens[0], st.TokenText.Data(), st.TokenText.Size());
+	for (int i = 0; i < NumTokens; i++)
+	{
+		Tokens[i] = Tokens[0] + st.TokenOfs[i];
+		TokenType[i] = st.TokenTypes[i];
+	}
+	LineStart = Script->data + st.LineStart;
+	Rover = Script->data + st.End;
+	Section = NULL;
+	if (st.HasSection)
+	{
+		// the brace is the last character of the statement
+		BraceType = st.BraceType;
+		Section = BraceType == bracket_open ? Script->FindSectionStart(Rover - 1) : Script->FindSectionEnd(Rover - 1);
+	}
 	return Rover;
 }
 
@@ -618,37 +693,42 @@ void FParser::PointlessBrackets(int *start, int *stop)
 
 //==========================================================================
 //
-// evaluate_expresion is the basic function used to evaluate
-// a FraggleScript expression.
-// start and stop denote the tokens which are to be evaluated.
-//
-// works by recursion: it finds operators in the expression
-// (checking for each in turn), then splits the expression into
-// 2 parts, left and right of the operator found.
-// The handler function for that particular operator is then
-// called, which in turn calls evaluate_expression again to
-// evaluate each side. When it reaches the level of being asked
-// to evaluate just 1 token, it calls simple_evaluate
+// PlanExpression: decides how a range of tokens is to be evaluated:
+// which operator splits it, or whether it is a single token or a
+// function call.
 //
 //==========================================================================
 
-void FParser::EvaluateExpression(svalue_t &result, int start, int stop)
+void FParser::PlanExpression(FsExprPlan &plan, int start, int stop)
 {
 	int i, n;
-	
+
+	plan.start = start;
+	plan.stop = stop;
+
 	// possible pointless brackets
 	if(TokenType[start] == operator_ && TokenType[stop] == operator_)
 		PointlessBrackets(&start, &stop);
 
+	plan.first = start;
+	plan.last = stop;
+
 	if(start == stop)       // only 1 thing to evaluate
-    {
-		SimpleEvaluate(result, start);
+	{
+		if (TokenType[start] == number)
+		{
+			plan.op = EXPR_NUMBER;
+			plan.isfloat = strchr(Tokens[start], '.') != nullptr;
+			if (plan.isfloat) plan.fval = atof(Tokens[start]);
+			else plan.ival = atoi(Tokens[start]);
+		}
+		else plan.op = EXPR_SIMPLE;
 		return;
-    }
+	}
 	
 	// go through each operator in order of precedence
 	for(i=0; i<num_operators; i++)
-    {
+	{
 		// check backwards for the token. it has to be
 		// done backwards for left-to-right reading: eg so
 		// 5-3-2 is (5-3)-2 not 5-(3-2)
@@ -664,24 +744,95 @@ void FParser::EvaluateExpression(svalue_t &result, int start, int stop)
 
 		if( n != -1)
 		{
-			// call the operator function and evaluate this chunk of tokens
-			(this->*operators[i].handler)(result, start, n, stop);
+			plan.op = i;
+			plan.n = n;
 			return;
 		}
-    }
+	}
 	
-	if(TokenType[start] == function)
+	plan.op = TokenType[start] == function ? EXPR_FUNCTION : EXPR_ERROR;
+}
+
+//==========================================================================
+//
+// evaluate_expresion is the basic function used to evaluate
+// a FraggleScript expression.
+// start and stop denote the tokens which are to be evaluated.
+//
+// works by recursion: it finds operators in the expression
+// (checking for each in turn), then splits the expression into
+// 2 parts, left and right of the operator found.
+// The handler function for that particular operator is then
+// called, which in turn calls evaluate_expression again to
+// evaluate each side. When it reaches the level of being asked
+// to evaluate just 1 token, it calls simple_evaluate
+//
+// How an expression splits only depends on its tokens, so for
+// cached statements this is only done once.
+//
+//==========================================================================
+
+void FParser::EvaluateExpression(svalue_t &result, int start, int stop)
+{
+	FsExprPlan plan;
+	bool found = false;
+
+	if (CurStatement >= 0)
 	{
-		EvaluateFunction(result, start, stop);
-		return;
+		// The operator handlers may add more plans, so work with a copy.
+		auto &plans = Script->Statements[CurStatement].Plans;
+		for (unsigned i = 0; i < plans.Size(); i++)
+		{
+			if (plans[i].start == start && plans[i].stop == stop)
+			{
+				plan = plans[i];
+				found = true;
+				break;
+			}
+		}
+		if (!found)
+		{
+			PlanExpression(plan, start, stop);
+			plans.Push(plan);
+		}
 	}
-	
-	// error ?
-	{        
+	else PlanExpression(plan, start, stop);
+
+	switch (plan.op)
+	{
+	case EXPR_NUMBER:
+		if (plan.isfloat)
+		{
+			result.setDouble(plan.fval);
+		}
+		else
+		{
+			result.type = svt_int;
+			result.value.i = plan.ival;
+		}
+		return;
+
+	case EXPR_SIMPLE:
+		SimpleEvaluate(result, plan.first);
+		return;
+
+	case EXPR_FUNCTION:
+		EvaluateFunction(result, plan.first, plan.last);
+		return;
+
+	case EXPR_ERROR:
+	{
 		FString tempstr;
 		
-		for(i=start; i<=stop; i++) tempstr << Tokens[i] << ' ';
+		for(int i=plan.first; i<=plan.last; i++) tempstr << Tokens[i] << ' ';
 		script_error("couldnt evaluate expression: %s\n",tempstr.GetChars());
+		return;
+	}
+
+	default:
+		// call the operator function and evaluate this chunk of tokens
+		(this->*operators[plan.op].handler)(result, plan.first, plan.n, plan.last);
+		return;
 	}
 }
 
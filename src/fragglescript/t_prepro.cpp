@@ -134,6 +134,19 @@ void DFsScript::ClearSections()
 	}
 }
 
+//==========================================================================
+//
+// the statement cache refers to positions in the script text
+// so it needs to be discarded whenever the text changes.
+//
+//==========================================================================
+
+void DFsScript::ClearStatementCache()
+{
+	Statements.Clear();
+	StatementIndex.Clear();
+}
+
 //==========================================================================
 //
 // create section
@@ -390,6 +403,7 @@ void DFsScript::DryRunScript(FLevelLocals *Level)
 void DFsScript::Preprocess(FLevelLocals *Level)
 {
 	len = (int)strlen(data);
+	ClearStatementCache();
 	ProcessFindChar(data, 0);  // fill in everything
 	DryRunScript(Level);
 }
@@ -159,6 +159,7 @@ void DFsScript::OnDestroy()
 	ClearVariables(true);
 	ClearSections();
 	ClearChildren();
+	ClearStatementCache();
 	parent = nullptr;
 	if (data != nullptr) delete [] data;
 	data = nullptr;
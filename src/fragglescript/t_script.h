@@ -264,6 +264,50 @@ enum    // brace types: where current_section is a { or }
 	bracket_close
 };
 
+//==========================================================================
+//
+// Statement cache
+//
+// FraggleScript runs directly off the script text so each statement
+// used to be tokenized again and each expression rescanned for its
+// operators every time it got executed. The text never changes once the
+// script has been preprocessed, so both results are kept per statement,
+// keyed by the statement's offset in the script. None of this gets
+// serialized, it is simply rebuilt on demand.
+//
+//==========================================================================
+
+enum
+{
+	EXPR_SIMPLE = -1,	// single token, not a number
+	EXPR_NUMBER = -2,	// single number token, value is cached
+	EXPR_FUNCTION = -3,	// function call
+	EXPR_ERROR = -4,	// not a valid expression
+};
+
+struct FsExprPlan
+{
+	int start, stop;	// the token range being asked for
+	int first, last;	// same without pointless brackets
+	int op;				// index into FParser::operators or one of the EXPR_ codes
+	int n;				// the operator's token
+	bool isfloat;
+	int ival;
+	double fval;
+};
+
+struct FsStatement
+{
+	TArray<char> TokenText;
+	TArray<int> TokenOfs;
+	TArray<tokentype_t> TokenTypes;
+	int LineStart;		// offsets in the script text
+	int End;
+	bool HasSection;	// statement ended in a brace
+	int BraceType;
+	TArray<FsExprPlan> Plans;
+};
+
 //==========================================================================
 //
 // Errors
@@ -334,6 +378,10 @@ public:
 	bool lastiftrue;     // haleyjd: whether last "if" statement was 
 	// true or false
 
+	// tokenized statements, see FParser::GetTokens
+	TArray<FsStatement> Statements;
+	TMap<int, int> StatementIndex;
+
 	DFsScript();
 	~DFsScript();
 	void OnDestroy() override;
@@ -353,6 +401,7 @@ public:
 	char *SectionLoop(const DFsSection *sec);
 	void ClearSections();
 	void ClearChildren();
+	void ClearStatementCache();
 
 	int MakeIndex(const char *p) { return int(p-data); }
 
@@ -405,6 +454,7 @@ struct FParser
 	DFsSection *Section;
 	DFsSection *PrevSection;
 	int BraceType;
+	int CurStatement;				// index into Script->Statements or -1
 
 	int t_argc;                     // number of arguments
 	svalue_t *t_argv;               // arguments
@@ -421,6 +471,7 @@ struct FParser
 		Script = scr;
 		Section = PrevSection = NULL;
 		BraceType = 0;
+		CurStatement = -1;
 	}
 
 	~FParser()
@@ -430,6 +481,8 @@ struct FParser
 
 	void NextToken();
 	char *GetTokens(char *s);
+	void CacheTokens(int ofs);
+	char *RestoreTokens(const FsStatement &st);
 	void PrintTokens();
 	void ErrorMessage(FString msg);
 
@@ -439,6 +492,7 @@ struct FParser
 	int FindOperatorBackwards(int start, int stop, const char *value);
 	void SimpleEvaluate(svalue_t &, int n);
 	void PointlessBrackets(int *start, int *stop);
+	void PlanExpression(FsExprPlan &plan, int start, int stop);
 	void EvaluateExpression(svalue_t &, int start, int stop);
 	void EvaluateFunction(svalue_t &, int start, int stop);
 
@@ -27,6 +27,8 @@
 #include <stdio.h>
 #include <stddef.h>
 #include <memory>
+#include <thread>
+#include <atomic>
 
 #include "i_time.h"
 #include "templates.h"
@@ -103,6 +105,8 @@ bool WriteZip(const char *filename, TArray<FString> &filenames, TArray<FCompress
 
 FIntCVar gameskill ("skill", 2, CVAR_SERVERINFO|CVAR_LATCH);
 CVAR(Bool, save_formatted, false, CVAR_ARCHIVE | CVAR_GLOBALCONFIG)	// use formatted JSON for saves (more readable but a larger files and a bit slower.
+CVAR(Bool, save_binary, false, CVAR_ARCHIVE | CVAR_GLOBALCONFIG)	// use the compact binary format for saves. Much faster on large maps but cannot be inspected.
+CVAR(Bool, save_async, true, CVAR_ARCHIVE | CVAR_GLOBALCONFIG)	// compress and write savegames on a background thread.
 CVAR (Int, deathmatch, 0, CVAR_SERVERINFO|CVAR_LATCH);
 CVAR (Bool, chasedemo, false, 0);
 CVAR (Bool, storesavepic, true, CVAR_ARCHIVE|CVAR_GLOBALCONFIG)
@@ -1799,6 +1803,8 @@ void G_DoLoadGame ()
 {
 	bool hidecon;
 
+	G_WaitForSave();
+
 	if (gameaction != ga_autoloadgame)
 	{
 		demoplayback = false;
@@ -2101,6 +2107,155 @@ static void PutSaveComment (FSerializer &arc)
 	arc.AddString("Comment", comment);
 }
 
+//==========================================================================
+//
+// Background savegame writing
+//
+// Only serializing the game state and rendering the save picture need
+// to be done on the main thread. Compressing the data, encoding the
+// picture and writing the file are left to a worker thread whose
+// result gets picked up by G_CheckPendingSave.
+//
+//==========================================================================
+
+class FSavePicWriter : public BufferWriter
+{
+	TArray<uint8_t> mPixels;
+	PalEntry mPalette[256];
+	bool mHasPalette = false;
+	ESSType mFormat = SS_RGB;
+	int mWidth = 0, mHeight = 0, mRowSize = 0;
+	float mGamma = 1.f;
+
+public:
+	// Copies the image so that it can be encoded later. Rows are stored top-down.
+	void Capture(const uint8_t *scr, const PalEntry *palette, ESSType ssformat, int width, int height, int pitch, float gamma)
+	{
+		mFormat = ssformat;
+		mWidth = width;
+		mHeight = height;
+		mRowSize = width * (ssformat == SS_RGB ? 3 : ssformat == SS_BGRA ? 4 : 1);
+		mGamma = gamma;
+		mHasPalette = palette != nullptr;
+		if (mHasPalette) memcpy(mPalette, palette, sizeof(mPalette));
+		mPixels.Resize(mRowSize * height);
+		for (int y = 0; y < height; y++)
+		{
+			memcpy(&mPixels[y * mRowSize], scr + y * pitch, mRowSize);
+		}
+	}
+
+	void Encode()
+	{
+		if (mPixels.Size() == 0) return;
+		M_CreatePNG(this, mPixels.Data(), mHasPalette ? mPalette : nullptr, mFormat, mWidth, mHeight, mRowSize, mGamma);
+		mPixels.Reset();
+	}
+};
+
+struct FSaveJob
+{
+	FString Filename;
+	FString Description;
+	bool OkForQuicksave;
+	FSavePicWriter SavePic;
+	FString Software, Title, MapName;
+	TArray<FString> Filenames;
+	TArray<FCompressedBuffer> Content;	// the first entry is the save picture which is owned by SavePic.
+	std::atomic<bool> Done{ false };
+
+	~FSaveJob()
+	{
+		for (unsigned i = 1; i < Content.Size(); i++)
+		{
+			Content[i].Clean();
+		}
+	}
+};
+
+static std::thread SaveThread;
+static FSaveJob *PendingSave;
+
+static void G_WriteSaveFile(FSaveJob *job)
+{
+	auto &savepic = job->SavePic;
+	savepic.Encode();
+	// put some basic info into the PNG so that this isn't lost when the image gets extracted.
+	M_AppendPNGText(&savepic, "Software", job->Software);
+	M_AppendPNGText(&savepic, "Title", job->Title);
+	M_AppendPNGText(&savepic, "Current Map", job->MapName);
+	M_FinishPNG(&savepic);
+
+	auto picdata = savepic.GetBuffer();
+	job->Content[0] = { picdata->Size(), picdata->Size(), METHOD_STORED, 0, static_cast<unsigned int>(crc32(0, &(*picdata)[0], picdata->Size())), (char*)&(*picdata)[0] };
+	for (unsigned i = 1; i < job->Content.Size(); i++)
+	{
+		job->Content[i].Compress();
+	}
+	WriteZip(job->Filename, job->Filenames, job->Content);
+	job->Done = true;
+}
+
+static void G_FinishSave(FSaveJob *job)
+{
+	savegameManager.NotifyNewSave (job->Filename, job->Description, job->OkForQuicksave);
+
+	// Check whether the file is ok by trying to open it.
+	FResourceFile *test = FResourceFile::OpenResourceFile(job->Filename, true);
+	if (test != nullptr)
+	{
+		delete test;
+		if (longsavemessages) Printf ("%s (%s)\n", GStrings("GGSAVED"), job->Filename.GetChars());
+		else Printf ("%s\n", GStrings("GGSAVED"));
+	}
+	else Printf(PRINT_HIGH, "%s\n", GStrings("TXT_SAVEFAILED"));
+
+	BackupSaveName = job->Filename;
+	delete job;
+}
+
+//==========================================================================
+//
+// Called once per frame to report a finished savegame.
+//
+//==========================================================================
+
+void G_CheckPendingSave()
+{
+	if (PendingSave != nullptr && PendingSave->Done)
+	{
+		G_WaitForSave();
+	}
+}
+
+//==========================================================================
+//
+// Blocks until the pending savegame has been written.
+// Must be called before anything that accesses the savegame files.
+//
+//==========================================================================
+
+void G_WaitForSave()
+{
+	if (PendingSave != nullptr)
+	{
+		SaveThread.join();
+		auto job = PendingSave;
+		PendingSave = nullptr;
+		G_FinishSave(job);
+	}
+}
+
+static void G_ShutdownSaveThread()
+{
+	if (PendingSave != nullptr)
+	{
+		SaveThread.join();
+		delete PendingSave;
+		PendingSave = nullptr;
+	}
+}
+
 void DoWriteSavePic(FileWriter *file, ESSType ssformat, uint8_t *scr, int width, int height, sector_t *viewsector, bool upsidedown)
 {
 	PalEntry palette[256];
@@ -2148,7 +2303,15 @@ void DoWriteSavePic(FileWriter *file, ESSType ssformat, uint8_t *scr, int width,
 		pitch *= -1;
 	}
 
-	M_CreatePNG(file, scr, ssformat == SS_PAL? palette : nullptr, ssformat, width, height, pitch, Gamma);
+	auto deferred = dynamic_cast<FSavePicWriter *>(file);
+	if (deferred != nullptr)
+	{
+		deferred->Capture(scr, ssformat == SS_PAL? palette : nullptr, ssformat, width, height, pitch, Gamma);
+	}
+	else
+	{
+		M_CreatePNG(file, scr, ssformat == SS_PAL? palette : nullptr, ssformat, width, height, pitch, Gamma);
+	}
 }
 
 static void PutSavePic (FileWriter *file, int width, int height)
@@ -2168,9 +2331,6 @@ static void PutSavePic (FileWriter *file, int width, int height)
 
 void G_DoSaveGame (bool okForQuicksave, FString filename, const char *description)
 {
-	TArray<FCompressedBuffer> savegame_content;
-	TArray<FString> savegame_filenames;
-
 	char buf[100];
 
 	// Do not even try, if we're not in a level. (Can happen after
@@ -2185,13 +2345,16 @@ void G_DoSaveGame (bool okForQuicksave, FString filename, const char *descriptio
 		filename = G_BuildSaveName ("demosave." SAVEGAME_EXT, -1);
 	}
 
+	// Only one savegame can be written at a time.
+	G_WaitForSave();
+
 	if (cl_waitforsave)
 		I_FreezeTime(true);
 
 	insave = true;
 	try
 	{
-		level.SnapshotLevel();
+		level.SnapshotLevel(false);
 	}
 	catch(CRecoverableError &err)
 	{
@@ -2213,21 +2376,23 @@ void G_DoSaveGame (bool okForQuicksave, FString filename, const char *descriptio
 		throw;
 	}
 
-	BufferWriter savepic;
+	std::unique_ptr<FSaveJob> job(new FSaveJob);
 	FSerializer savegameinfo(nullptr);		// this is for displayable info about the savegame
 	FSerializer savegameglobals(nullptr);	// and this for non-level related info that must be saved.
 
 	savegameinfo.OpenWriter(true);
-	savegameglobals.OpenWriter(save_formatted);
+	if (save_binary) savegameglobals.OpenBinaryWriter();
+	else savegameglobals.OpenWriter(save_formatted);
 
 	SaveVersion = SAVEVER;
-	PutSavePic(&savepic, SAVEPICWIDTH, SAVEPICHEIGHT);
+	PutSavePic(&job->SavePic, SAVEPICWIDTH, SAVEPICHEIGHT);
 	mysnprintf(buf, countof(buf), GAMENAME " %s", GetVersionString());
-	// put some basic info into the PNG so that this isn't lost when the image gets extracted.
-	M_AppendPNGText(&savepic, "Software", buf);
-	M_AppendPNGText(&savepic, "Title", description);
-	M_AppendPNGText(&savepic, "Current Map", primaryLevel->MapName);
-	M_FinishPNG(&savepic);
+	job->Filename = filename;
+	job->Description = description;
+	job->OkForQuicksave = okForQuicksave;
+	job->Software = buf;
+	job->Title = description;
+	job->MapName = primaryLevel->MapName;
 
 	int ver = SAVEVER;
 	savegameinfo.AddString("Software", buf)
@@ -2267,48 +2432,55 @@ void G_DoSaveGame (bool okForQuicksave, FString filename, const char *descriptio
 		savegameglobals("nextskill", NextSkill);
 	}
 
-	auto picdata = savepic.GetBuffer();
-	FCompressedBuffer bufpng = { picdata->Size(), picdata->Size(), METHOD_STORED, 0, static_cast<unsigned int>(crc32(0, &(*picdata)[0], picdata->Size())), (char*)&(*picdata)[0] };
+	// The picture gets filled in by the writer.
+	job->Content.Push({ 0, 0, METHOD_STORED, 0, 0, nullptr });
+	job->Filenames.Push("savepic.png");
+	job->Content.Push(savegameinfo.GetCompressedOutput(false));
+	job->Filenames.Push("info.json");
+	job->Content.Push(savegameglobals.GetCompressedOutput(false));
+	job->Filenames.Push("globals.json");
 
-	savegame_content.Push(bufpng);
-	savegame_filenames.Push("savepic.png");
-	savegame_content.Push(savegameinfo.GetCompressedOutput());
-	savegame_filenames.Push("info.json");
-	savegame_content.Push(savegameglobals.GetCompressedOutput());
-	savegame_filenames.Push("globals.json");
+	G_WriteSnapshots (job->Filenames, job->Content);
 
-	G_WriteSnapshots (savegame_filenames, savegame_content);
-	
-
-	WriteZip(filename, savegame_filenames, savegame_content);
-
-	savegameManager.NotifyNewSave (filename, description, okForQuicksave);
-
-	// delete the JSON buffers we created just above. Everything else will
-	// either still be needed or taken care of automatically.
-	savegame_content[1].Clean();
-	savegame_content[2].Clean();
-
-	// Check whether the file is ok by trying to open it.
-	FResourceFile *test = FResourceFile::OpenResourceFile(filename, true);
-	if (test != nullptr)
+	// The snapshots of other levels remain in use, so the writer needs its own copies.
+	// We don't need the current level's snapshot any longer so it can be handed over.
+	for (unsigned i = 3; i < job->Content.Size(); i++)
 	{
-		delete test;
-		if (longsavemessages) Printf ("%s (%s)\n", GStrings("GGSAVED"), filename.GetChars());
-		else Printf ("%s\n", GStrings("GGSAVED"));
+		auto &buff = job->Content[i];
+		if (buff.mBuffer == level.info->Snapshot.mBuffer)
+		{
+			level.info->Snapshot.mBuffer = nullptr;
+		}
+		else
+		{
+			auto copy = new char[buff.mCompressedSize];
+			memcpy(copy, buff.mBuffer, buff.mCompressedSize);
+			buff.mBuffer = copy;
+		}
 	}
-	else Printf(PRINT_HIGH, "%s\n", GStrings("TXT_SAVEFAILED"));
-
-
-	BackupSaveName = filename;
-
-	// We don't need the snapshot any longer.
 	level.info->Snapshot.Clean();
-		
+
 	insave = false;
 
 	if (cl_waitforsave)
 		I_FreezeTime(false);
+
+	if (save_async)
+	{
+		static bool registered;
+		if (!registered)
+		{
+			atterm(G_ShutdownSaveThread);
+			registered = true;
+		}
+		PendingSave = job.release();
+		SaveThread = std::thread(G_WriteSaveFile, PendingSave);
+	}
+	else
+	{
+		G_WriteSaveFile(job.get());
+		G_FinishSave(job.release());
+	}
 }
 
 
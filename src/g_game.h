@@ -83,6 +83,10 @@ void G_DoLoadGame (void);
 // Called by M_Responder.
 void G_SaveGame (const char *filename, const char *description);
 
+// Savegames are written by a background thread. These pick up its result.
+void G_CheckPendingSave ();
+void G_WaitForSave ();
+
 // Only called by startup code.
 void G_RecordDemo (const char* name);
 
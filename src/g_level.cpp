@@ -2033,6 +2033,16 @@ void FLevelLocals::Mark()
 	{
 		GC::Mark(c);
 	}
+	for (auto &e : SightPrecalc.entries)
+	{
+		GC::Mark(e.t1);
+		GC::Mark(e.t2);
+	}
+	GC::Mark(RadiusSightCache.bombspot);
+	for (auto &e : RadiusSightCache.entries)
+	{
+		GC::Mark(e.thing);
+	}
 	for (auto &s : sectorPortals)
 	{
 		GC::Mark(s.mSkybox);
@@ -98,6 +98,95 @@ class DSectorMarker;
 struct FTranslator;
 struct EventManager;
 
+//==========================================================================
+//
+// Sight checks that were run ahead of the monsters' think phase by
+// P_PrecalcSight. They are only good for the tic they were made in and
+// as long as neither actor has moved and no map geometry has changed.
+//
+//==========================================================================
+
+struct FSightPrecalc
+{
+	struct Entry
+	{
+		AActor *t1;
+		AActor *t2;
+		DVector3 pos1, pos2;
+		double height1, height2;
+		int flags;
+		bool result;
+	};
+
+	int maptime = -1;
+	unsigned scriptcalls;				// VMScriptCallCount when the traces were made
+	unsigned generation = 0;			// counts the calls to Invalidate
+	TArray<Entry> entries;
+	TMap<AActor *, unsigned> first;		// first entry of each looker; a looker's entries are contiguous
+
+	// Called by everything in native code that can change what blocks sight.
+	// Script code is caught by comparing the number of script calls.
+	void Invalidate()
+	{
+		maptime = -1;
+		generation++;
+	}
+
+	void Clear()
+	{
+		maptime = -1;
+		entries.Clear();
+		first.Clear();
+	}
+};
+
+//==========================================================================
+//
+// Sight checks of radius attacks at one spot. An actor that explodes
+// several times in a row (several A_Explode calls in one state, different
+// damage types etc.) checks the same things again, so the results are
+// kept until either end moves or anything could have changed the map,
+// with the same rules as FSightPrecalc.
+//
+//==========================================================================
+
+struct FRadiusSightCache
+{
+	struct Entry
+	{
+		AActor *thing;
+		DVector3 pos;
+		double height;
+		bool result;
+	};
+
+	AActor *bombspot = nullptr;
+	DVector3 spotpos;
+	double spotheight;
+	int maptime = -1;
+	unsigned generation;				// FSightPrecalc::generation
+	unsigned scriptcalls;				// VMScriptCallCount
+	TArray<Entry> entries;
+	TMap<AActor *, unsigned> index;
+
+	void Clear()
+	{
+		bombspot = nullptr;
+		maptime = -1;
+		entries.Clear();
+		index.Clear();
+	}
+};
+
+// One line of a sector as seen by P_NoiseAlert.
+struct FNoiseEdge
+{
+	line_t *line;
+	sector_t *other;	// sector on the other side, if it is a different one
+	sector_t *upper;	// sectors behind the plane portals at the line's center
+	sector_t *lower;
+};
+
 typedef TMap<int, int> FDialogueIDMap;				// maps dialogue IDs to dialogue array index (for ACS)
 typedef TMap<FName, int> FDialogueMap;				// maps actor class names to dialogue array index
 typedef TMap<int, FUDMFKeys> FUDMFKeyMap;
@@ -166,7 +255,7 @@ private:
 	void SerializeSounds(FSerializer &arc);
 
 public:
-	void SnapshotLevel();
+	void SnapshotLevel(bool compress = true);
 	void UnSnapshotLevel(bool hubLoad);
 
 	void FinalizePortals();
@@ -392,7 +481,13 @@ public:
 
 	void ClearTIDHashes ()
 	{
-		memset(TIDHash, 0, sizeof(TIDHash));
+		TIDHash.Clear();
+	}
+
+	// All live actors of exactly this class, in no particular order.
+	const TArray<AActor *> *GetActorsOfClass(PClassActor *cls)
+	{
+		return ActorsByClass.CheckKey(cls);
 	}
 
 
@@ -479,7 +574,8 @@ public:
 	TArray<FPlayerStart> AllPlayerStarts;
 
 	FBehaviorContainer Behaviors;
-	AActor *TIDHash[128];
+	FTIDHash TIDHash;
+	TMap<PClassActor *, TArray<AActor *>> ActorsByClass;
 
 	TArray<FStrifeDialogueNode *> StrifeDialogues;
 	FDialogueIDMap DialogueRoots;
@@ -663,6 +759,13 @@ public:
 
 	// links to global game objects
 	TArray<TObjPtr<AActor *>> CorpseQueue;
+	FSightPrecalc SightPrecalc;
+	FRadiusSightCache RadiusSightCache;
+
+	// Sound propagation graph, built on first use by P_NoiseAlert
+	TArray<FNoiseEdge> NoiseGraph;
+	TArray<unsigned> NoiseGraphStart;		// first edge per sector, plus one end marker
+	TArray<unsigned> NoiseGraphPortals;		// portal that upper/lower were found with, two per sector
 	TObjPtr<DFraggleThinker *> FraggleScriptThinker = nullptr;
 	TObjPtr<DACSThinker*> ACSThinker = nullptr;
 
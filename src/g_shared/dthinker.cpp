@@ -111,6 +111,7 @@ void FThinkerCollection::RunThinkers(FLevelLocals *Level)
 		// Tick every thinker left from last time
 		for (i = STAT_FIRST_THINKING; i <= MAX_STATNUM; ++i)
 		{
+			if (i == STAT_DEFAULT) P_PrecalcSight(Level);
 			Thinkers[i].TickThinkers(nullptr);
 		}
 
@@ -137,6 +138,7 @@ void FThinkerCollection::RunThinkers(FLevelLocals *Level)
 		// Tick every thinker left from last time
 		for (i = STAT_FIRST_THINKING; i <= MAX_STATNUM; ++i)
 		{
+			if (i == STAT_DEFAULT) P_PrecalcSight(Level);
 			Thinkers[i].ProfileThinkers(nullptr);
 		}
 
@@ -37,6 +37,28 @@
 msecnode_t *headsecnode = nullptr;
 FMemArena secnodearena;
 
+// Incremented whenever a node gets added to or removed from a sector's
+// touching_thinglist so that P_ChangeSector knows when it has to rescan.
+unsigned int thinglist_changes;
+
+static inline void NoteSecnodeChange(sector_t *s, msecnode_t *&list)
+{
+	if (&list == &s->touching_thinglist) thinglist_changes++;
+}
+
+static inline void NoteSecnodeChange(FLinePortal *, portnode_t *&)
+{
+}
+
+static inline void NoteSecnodeChange(msecnode_t *sector_t::*listhead)
+{
+	if (listhead == &sector_t::touching_thinglist) thinglist_changes++;
+}
+
+static inline void NoteSecnodeChange(portnode_t *FLinePortal::*)
+{
+}
+
 //=============================================================================
 //
 // P_GetSecnode
@@ -131,6 +153,7 @@ nodetype *P_AddSecnode(linktype *s, AActor *thing, nodetype *nextnode, nodetype
 	if (sec_thinglist)
 		node->m_snext->m_sprev = node;
 	sec_thinglist = node;
+	NoteSecnodeChange(s, sec_thinglist);
 	return node;
 }
 
@@ -178,6 +201,7 @@ nodetype *P_DelSecnode(nodetype *node, nodetype *linktype::*listhead)
 			node->m_sector->*listhead = sn;
 		if (sn)
 			sn->m_sprev = sp;
+		NoteSecnodeChange(listhead);
 
 		// Return this node to the freelist
 
@@ -1600,5 +1600,6 @@ void vertex_t::RecalcVertexHeights()
 	}
 	if (numheights <= 2) numheights = 0;	// is not in need of any special attention
 	dirty = false;
+	heightgen++;
 }
 
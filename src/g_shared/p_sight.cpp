@@ -21,6 +21,7 @@
 //-----------------------------------------------------------------------------
 //
 #include <assert.h>
+#include <atomic>
 
 #include "doomdef.h"
 
@@ -33,6 +34,8 @@
 #include "b_bot.h"
 #include "p_spec.h"
 #include "vm.h"
+#include "c_cvars.h"
+#include "parallel_for.h"
 
 #include "g_levellocals.h"
 #include "actorinlines.h"
@@ -40,6 +43,12 @@
 static FRandom pr_botchecksight ("BotCheckSight");
 static FRandom pr_checksight ("CheckSight");
 
+// Runs the line of sight traces of the monsters that are about to act
+// on several threads before the monsters think. The results are only used
+// as long as nothing can have changed the map since, so this does not
+// change what the monsters see.
+CVAR(Bool, sv_parallelsight, false, CVAR_SERVERINFO)
+
 /*
 ==============================================================================
 
@@ -51,7 +60,7 @@ This uses specialized forms of the maputils routines for optimized performance
 */
 
 // Performance meters
-static int sightcounts[6];
+static thread_local int sightcounts[6];
 static cycle_t SightCycles;
 static cycle_t MaxSightCycles;
 
@@ -87,8 +96,48 @@ struct SightTask
 };
 
 
-static TArray<intercept_t> intercepts (128);
-static TArray<SightTask> portals(32);
+// Everything a trace writes to is kept per thread so that
+// P_PrecalcSight can run several traces at once.
+static thread_local TArray<intercept_t> intercepts (128);
+static thread_local TArray<SightTask> portals(32);
+
+//==========================================================================
+//
+// Lines and polyobjects a trace has already checked. This takes the place
+// of validcount, which cannot be shared between threads.
+//
+//==========================================================================
+
+struct SightVisited
+{
+	TArray<int> Lines;
+	TArray<int> Polys;
+	int Stamp = 0;
+
+	void Next(FLevelLocals *Level)
+	{
+		if (Lines.Size() != Level->lines.Size() || Polys.Size() != Level->Polyobjects.Size() || Stamp == INT_MAX)
+		{
+			Lines.Resize(Level->lines.Size());
+			Polys.Resize(Level->Polyobjects.Size());
+			memset(Lines.Data(), 0, Lines.Size() * sizeof(int));
+			memset(Polys.Data(), 0, Polys.Size() * sizeof(int));
+			Stamp = 0;
+		}
+		// Stamps are never reused, so whatever is left over from a previous
+		// level of the same size can't match.
+		Stamp++;
+	}
+
+	bool Visit(int &mark)
+	{
+		if (mark == Stamp) return false;
+		mark = Stamp;
+		return true;
+	}
+};
+
+static thread_local SightVisited sightvisited;
 
 class SightCheck
 {
@@ -434,11 +483,10 @@ bool SightCheck::P_SightCheckLine (line_t *ld)
 {
 	divline_t dl;
 
-	if (ld->validcount == validcount)
+	if (!sightvisited.Visit(sightvisited.Lines[ld->Index()]))
 	{
 		return true;
 	}
-	ld->validcount = validcount;
 	if (P_PointOnDivlineSide (ld->v1->fPos(), &Trace) ==
 		P_PointOnDivlineSide (ld->v2->fPos(), &Trace))
 	{
@@ -495,9 +543,8 @@ int SightCheck::P_SightBlockLinesIterator (int x, int y)
 	{
 		if (polyLink->polyobj)
 		{ // only check non-empty links
-			if (polyLink->polyobj->validcount != validcount)
+			if (sightvisited.Visit(sightvisited.Polys[unsigned(polyLink->polyobj - &Level->Polyobjects[0])]))
 			{
-				polyLink->polyobj->validcount = validcount;
 				for (i = 0; i < polyLink->polyobj->Linedefs.Size(); i++)
 				{
 					if (!P_SightCheckLine(polyLink->polyobj->Linedefs[i]))
@@ -627,7 +674,7 @@ bool SightCheck::P_SightPathTraverse ()
 	int mapx, mapy, mapxstep, mapystep;
 	int count;
 
-	validcount++;
+	sightvisited.Next(Level);
 	intercepts.Clear ();
 	x1 = sightstart.X + Startfrac * Trace.dx;
 	y1 = sightstart.Y + Startfrac * Trace.dy;
@@ -826,6 +873,90 @@ sightcounts[2]++;
 	return traverseres;
 }
 
+//==========================================================================
+//
+// P_SightTraverse
+//
+// The part of P_CheckSight that only depends on the map and on where the
+// two actors are. Safe to call from several threads at once.
+//
+//==========================================================================
+
+static bool P_SightTraverse(AActor *t1, AActor *t2, int flags)
+{
+	bool res;
+
+	portals.Clear();
+	sector_t *sec;
+	double lookheight = t1->Z() + t1->Height*0.75;
+	t1->GetPortalTransition(lookheight, &sec);
+
+	double bottomslope = t2->Z() - lookheight;
+	double topslope = bottomslope + t2->Height;
+	SightTask task = { 0, topslope, bottomslope, -1, sec->PortalGroup };
+
+
+	SightCheck s(t1->Level);
+	s.init(t1, t2, sec, &task, flags);
+	res = s.P_SightPathTraverse ();
+	if (!res)
+	{
+		double dist = t1->Distance2D(t2);
+		for (unsigned i = 0; i < portals.Size(); i++)
+		{
+			portals[i].Frac += 1 / dist;
+			s.init(t1, t2, NULL, &portals[i], flags);
+			if (s.P_SightPathTraverse())
+			{
+				res = true;
+				break;
+			}
+		}
+	}
+	return res;
+}
+
+//==========================================================================
+//
+// P_FindPrecalcSight
+//
+// Returns the result P_PrecalcSight got for this check or -1 if there is
+// none that is still valid.
+//
+//==========================================================================
+
+static int P_FindPrecalcSight(AActor *t1, AActor *t2, int flags)
+{
+	auto &pc = t1->Level->SightPrecalc;
+
+	if (pc.maptime != t1->Level->maptime)
+	{
+		return -1;
+	}
+	// Scripts may have changed line flags, sector planes or anything else directly.
+	if (pc.scriptcalls != VMScriptCallCount)
+	{
+		pc.Invalidate();
+		return -1;
+	}
+	auto first = pc.first.CheckKey(t1);
+	if (first == nullptr)
+	{
+		return -1;
+	}
+	for (unsigned i = *first; i < pc.entries.Size() && pc.entries[i].t1 == t1; i++)
+	{
+		auto &e = pc.entries[i];
+		if (e.t2 == t2 && e.flags == flags &&
+			e.pos1 == t1->Pos() && e.height1 == t1->Height &&
+			e.pos2 == t2->Pos() && e.height2 == t2->Height)
+		{
+			return e.result;
+		}
+	}
+	return -1;
+}
+
 /*
 =====================
 =
@@ -900,35 +1031,9 @@ sightcounts[0]++;
 	// An unobstructed LOS is possible.
 	// Now look from eyes of t1 to any part of t2.
 
-	validcount++;
-	portals.Clear();
 	{
-		sector_t *sec;
-		double lookheight = t1->Z() + t1->Height*0.75;
-		t1->GetPortalTransition(lookheight, &sec);
-
-		double bottomslope = t2->Z() - lookheight;
-		double topslope = bottomslope + t2->Height;
-		SightTask task = { 0, topslope, bottomslope, -1, sec->PortalGroup };
-
-
-		SightCheck s(t1->Level);
-		s.init(t1, t2, sec, &task, flags);
-		res = s.P_SightPathTraverse ();
-		if (!res)
-		{
-			double dist = t1->Distance2D(t2);
-			for (unsigned i = 0; i < portals.Size(); i++)
-			{
-				portals[i].Frac += 1 / dist;
-				s.init(t1, t2, NULL, &portals[i], flags);
-				if (s.P_SightPathTraverse())
-				{
-					res = true;
-					break;
-				}
-			}
-		}
+		int precalc = P_FindPrecalcSight(t1, t2, flags);
+		res = precalc >= 0 ? !!precalc : P_SightTraverse(t1, t2, flags);
 	}
 
 done:
@@ -945,6 +1050,100 @@ ADD_STAT (sight)
 	return out;
 }
 
+//==========================================================================
+//
+// P_PrecalcSight
+//
+// Called right before the monsters think. Collects the sight checks the
+// monsters that are about to change state are most likely to make and
+// traces them on all cores. Only the traces are done here; the reject,
+// visibility and fake floor checks (the first one of which uses the RNG)
+// are still done when P_CheckSight gets called, so the results are the
+// same with or without this.
+//
+//==========================================================================
+
+void P_PrecalcSight(FLevelLocals *Level)
+{
+	auto &pc = Level->SightPrecalc;
+
+	pc.Clear();
+	if (!sv_parallelsight)
+	{
+		return;
+	}
+
+	auto add = [&](AActor *t1, AActor *t2, int flags)
+	{
+		if (!Level->CheckReject(t1->Sector, t2->Sector)) return;
+		if (pc.first.CheckKey(t1) == nullptr) pc.first[t1] = pc.entries.Size();
+		pc.entries.Push({ t1, t2, t1->Pos(), t2->Pos(), t1->Height, t2->Height, flags, false });
+	};
+
+	auto it = Level->GetThinkerIterator<AActor>(NAME_None, STAT_DEFAULT);
+	AActor *mo;
+	while ((mo = it.Next()))
+	{
+		// Only monsters whose current state runs out this tic will call an action function.
+		if (!(mo->flags3 & MF3_ISMONSTER) || (mo->flags2 & MF2_DORMANT) || mo->health <= 0 || mo->tics != 1)
+		{
+			continue;
+		}
+		AActor *target = mo->target;
+		if (target != nullptr && target != mo)
+		{
+			add(mo, target, SF_SEEPASTBLOCKEVERYTHING);		// P_CheckMissileRange
+			if (mo->Distance2D(target) < mo->meleerange + target->radius)
+			{
+				add(mo, target, 0);							// AActor::CheckMeleeRange
+			}
+		}
+		else
+		{
+			for (int i = 0; i < MAXPLAYERS; i++)
+			{
+				if (Level->PlayerInGame(i) && Level->Players[i]->mo != nullptr && Level->Players[i]->health > 0)
+				{
+					add(mo, Level->Players[i]->mo, SF_SEEPASTSHOOTABLELINES);	// P_IsVisible
+				}
+			}
+		}
+	}
+
+	// Not worth waking up the other threads for a handful of traces.
+	if (pc.entries.Size() < 32)
+	{
+		pc.Clear();
+		return;
+	}
+
+	// The worker threads count into their own copy of the sight stats,
+	// so their counts get collected here and added to the main thread's.
+	std::atomic<int> counts[countof(sightcounts)] = {};
+	int count = pc.entries.Size();
+	parallel_for(count, [&](int i)
+	{
+		if (i < count)
+		{
+			int before[countof(sightcounts)];
+			memcpy(before, sightcounts, sizeof(before));
+			auto &e = pc.entries[i];
+			e.result = P_SightTraverse(e.t1, e.t2, e.flags);
+			for (unsigned j = 0; j < countof(sightcounts); j++)
+			{
+				counts[j] += sightcounts[j] - before[j];
+				sightcounts[j] = before[j];
+			}
+		}
+	});
+	for (unsigned j = 0; j < countof(sightcounts); j++)
+	{
+		sightcounts[j] += counts[j];
+	}
+	pc.maptime = Level->maptime;
+	pc.scriptcalls = VMScriptCallCount;
+}
+
 void P_ResetSightCounters (bool full)
 {
 	if (full)
@@ -859,6 +859,7 @@ void FPolyObj::CalcCenter()
 bool FPolyObj::MovePolyobj (const DVector2 &pos, bool force)
 {
 	FBoundingBox oldbounds = Bounds;
+	Level->SightPrecalc.Invalidate();
 	UnLinkPolyobj ();
 	DoMovePolyobj (pos);
 
@@ -941,6 +942,7 @@ bool FPolyObj::RotatePolyobj (DAngle angle, bool fromsave)
 
 	an = Angle + angle;
 
+	Level->SightPrecalc.Invalidate();
 	UnLinkPolyobj();
 
 	for(unsigned i=0;i < Vertices.Size(); i++)
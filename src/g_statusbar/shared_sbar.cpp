@@ -96,6 +96,12 @@ extern int setblocks;
 FTexture *CrosshairImage;
 static int CrosshairNum;
 
+// The border only changes with the screen layout so it gets recorded once
+// and replayed until any of that changes. The lists reference textures
+// directly so the texture manager's generation is part of the key and
+// ST_Clear throws them away before a restart deletes the textures.
+static F2DDrawer::FDisplayList ViewBorderList, BackgroundList;
+
 CVAR (Int, paletteflash, 0, CVAR_ARCHIVE)
 CVAR (Flag, pf_hexenweaps,	paletteflash, PF_HEXENWEAPONS)
 CVAR (Flag, pf_poison,		paletteflash, PF_POISON)
@@ -208,6 +214,8 @@ void ST_Clear()
 	}
 	CrosshairImage = NULL;
 	CrosshairNum = 0;
+	ViewBorderList.Invalidate();
+	BackgroundList.Invalidate();
 }
 
 //---------------------------------------------------------------------------
@@ -969,12 +977,20 @@ void DBaseStatusBar::RefreshViewBorder ()
 			return;
 		}
 		auto tex = GetBorderTexture(primaryLevel);
+		int top = StatusBar->GetTopOfStatusbar();
+		int cx, cy, cw, ch;
+		screen->GetClipRect(&cx, &cy, &cw, &ch);
+		if (!screen->BeginDisplayList(ViewBorderList, { Width, screen->GetHeight(), viewwindowx, viewwindowy, viewwidth, viewheight, top, tex.GetIndex(), TexMan.GetGeneration(), cx, cy, cw, ch }))
+		{
+			return;
+		}
 		screen->DrawBorder (tex, 0, 0, Width, viewwindowy);
 		screen->DrawBorder (tex, 0, viewwindowy, viewwindowx, viewheight + viewwindowy);
 		screen->DrawBorder (tex, viewwindowx + viewwidth, viewwindowy, Width, viewheight + viewwindowy);
-		screen->DrawBorder (tex, 0, viewwindowy + viewheight, Width, StatusBar->GetTopOfStatusbar());
+		screen->DrawBorder (tex, 0, viewwindowy + viewheight, Width, top);
 		
 		screen->DrawFrame (viewwindowx, viewwindowy, viewwidth, viewheight);
+		screen->EndDisplayList(ViewBorderList);
 	}
 }
 
@@ -995,6 +1011,12 @@ void DBaseStatusBar::RefreshBackground () const
 	if (x == 0 && y == SCREENHEIGHT) return;
 
 	auto tex = GetBorderTexture(primaryLevel);
+	int cx, cy, cw, ch;
+	screen->GetClipRect(&cx, &cy, &cw, &ch);
+	if (!screen->BeginDisplayList(BackgroundList, { SCREENWIDTH, SCREENHEIGHT, x, y, CompleteBorder, setblocks >= 10, tex.GetIndex(), TexMan.GetGeneration(), cx, cy, cw, ch }))
+	{
+		return;
+	}
 
 	if(!CompleteBorder)
 	{
@@ -1033,6 +1055,7 @@ void DBaseStatusBar::RefreshBackground () const
 			}
 		}
 	}
+	screen->EndDisplayList(BackgroundList);
 }
 
 //---------------------------------------------------------------------------
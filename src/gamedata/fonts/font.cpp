@@ -481,6 +481,11 @@ FFont::~FFont ()
 	{
 		*prev = font->Next;
 	}
+
+	for (auto atlas : Atlases)
+	{
+		TexMan.RemoveTexture(atlas);
+	}
 }
 
 //==========================================================================
@@ -982,6 +987,148 @@ FTexture *FFont::GetChar (int code, int translation, int *const width, bool *red
 	return Chars[code].TranslatedPic;
 }
 
+//==========================================================================
+//
+// FFont :: GetAtlasChar
+//
+// Returns the atlas texture containing the given character's image and
+// the image's position in it, or nullptr if the character is not part of
+// an atlas. 'pic' must be what GetChar returned for this character.
+// Drawing text from a shared atlas lets the 2D drawer merge consecutive
+// characters into a single draw command.
+//
+//==========================================================================
+
+static const unsigned AtlasPageChars = 256;	// Number of character codes that share one atlas.
+static const int AtlasMaxSize = 2048;
+static const int AtlasPadding = 2;			// Keeps texture filtering from picking up the neighbors.
+
+FTexture *FFont::GetAtlasChar(int code, FTexture *pic, FloatRect &rect)
+{
+	code = GetCharCode(code, true);
+	if (code < 0 || pic == nullptr) return nullptr;
+
+	unsigned index = code - FirstChar;
+	if (index >= Chars.Size()) return nullptr;
+
+	auto &ch = Chars[index];
+	int which = pic == ch.TranslatedPic ? 0 : pic == ch.OriginalPic ? 1 : -1;
+	if (which < 0) return nullptr;
+
+	unsigned page = index / AtlasPageChars;
+	unsigned numpages = (Chars.Size() + AtlasPageChars - 1) / AtlasPageChars;
+	if (AtlasPages.Size() != numpages)
+	{
+		AtlasPages.Resize(numpages);
+		memset(AtlasPages.Data(), 0, numpages);
+	}
+	if (!(AtlasPages[page] & (1 << which)))
+	{
+		AtlasPages[page] |= 1 << which;
+		BuildAtlasPage(page, which);
+	}
+	if (ch.AtlasPic[which] == nullptr) return nullptr;
+
+	rect.left = ch.AtlasRect[which][0];
+	rect.top = ch.AtlasRect[which][1];
+	rect.width = ch.AtlasRect[which][2];
+	rect.height = ch.AtlasRect[which][3];
+	return ch.AtlasPic[which];
+}
+
+//==========================================================================
+//
+// FFont :: BuildAtlasPage
+//
+// Packs the character images of one group of character codes into a
+// shared texture, using simple shelf packing. Anything that does not
+// fit is left alone and will be drawn from its own texture.
+//
+//==========================================================================
+
+void FFont::BuildAtlasPage(unsigned page, int which)
+{
+	unsigned first = page * AtlasPageChars;
+	unsigned last = MIN<unsigned>(first + AtlasPageChars, Chars.Size());
+	TArray<FTexture *> pics;
+	int area = 0, maxwidth = 0;
+
+	for (unsigned i = first; i < last; i++)
+	{
+		FTexture *pic = which == 0 ? Chars[i].TranslatedPic : Chars[i].OriginalPic;
+		// Characters whose original image is the translated one use the first atlas.
+		if (pic == nullptr || (which == 1 && pic == Chars[i].TranslatedPic)) continue;
+		auto img = pic->GetImage();
+		if (img == nullptr || pics.Find(pic) < pics.Size()) continue;
+		int w = img->GetWidth() + AtlasPadding;
+		int h = img->GetHeight() + AtlasPadding;
+		if (w > AtlasMaxSize || h > AtlasMaxSize) continue;
+		pics.Push(pic);
+		area += w * h;
+		maxwidth = MAX(maxwidth, w);
+	}
+	if (pics.Size() < 2) return;	// Not worth it.
+
+	// Tallest images first so that the shelves don't waste much space.
+	std::sort(pics.begin(), pics.end(), [](FTexture *a, FTexture *b)
+	{
+		return a->GetImage()->GetHeight() > b->GetImage()->GetHeight();
+	});
+
+	int width = 64;
+	while (width < maxwidth || width * width < area) width <<= 1;
+	width = MIN(width, AtlasMaxSize);
+
+	TArray<TexPart> parts;
+	int x = AtlasPadding, y = AtlasPadding, shelfheight = 0;
+	for (auto pic : pics)
+	{
+		auto img = pic->GetImage();
+		int w = img->GetWidth();
+		int h = img->GetHeight();
+		if (x + w + AtlasPadding > width)
+		{
+			x = AtlasPadding;
+			y += shelfheight;
+			shelfheight = 0;
+		}
+		if (y + h + AtlasPadding > AtlasMaxSize) break;
+
+		auto &tp = parts[parts.Reserve(1)];
+		tp.Image = img;
+		tp.OriginX = x;
+		tp.OriginY = y;
+		x += w + AtlasPadding;
+		shelfheight = MAX(shelfheight, h + AtlasPadding);
+	}
+	if (parts.Size() < 2) return;
+
+	int height = y + shelfheight;
+	FImageTexture *atlas = new FImageTexture(new FMultiPatchTexture(width, height, parts, false, false), "");
+	atlas->SetUseType(ETextureType::FontChar);
+	TexMan.AddTexture(atlas);
+	Atlases.Push(atlas);
+
+	for (unsigned i = first; i < last; i++)
+	{
+		FTexture *pic = which == 0 ? Chars[i].TranslatedPic : Chars[i].OriginalPic;
+		if (pic == nullptr || (which == 1 && pic == Chars[i].TranslatedPic)) continue;
+		auto img = pic->GetImage();
+		for (auto &tp : parts)
+		{
+			if (tp.Image == img)
+			{
+				Chars[i].AtlasPic[which] = atlas;
+				Chars[i].AtlasRect[which][0] = float(tp.OriginX) / width;
+				Chars[i].AtlasRect[which][1] = float(tp.OriginY) / height;
+				Chars[i].AtlasRect[which][2] = float(img->GetWidth()) / width;
+				Chars[i].AtlasRect[which][3] = float(img->GetHeight()) / height;
+				break;
+			}
+		}
+	}
+}
+
 //==========================================================================
 //
 // FFont :: GetCharWidth
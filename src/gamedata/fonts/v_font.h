@@ -41,6 +41,7 @@
 class DCanvas;
 struct FRemapTable;
 class FTexture;
+struct FloatRect;
 
 enum EColorRange : int
 {
@@ -97,6 +98,7 @@ public:
 	virtual ~FFont ();
 
 	virtual FTexture *GetChar (int code, int translation, int *const width, bool *redirected = nullptr) const;
+	FTexture *GetAtlasChar(int code, FTexture *pic, FloatRect &rect);
 	virtual int GetCharWidth (int code) const;
 	FRemapTable *GetColorTranslation (EColorRange range, PalEntry *color = nullptr) const;
 	int GetLump() const { return Lump; }
@@ -140,6 +142,7 @@ protected:
 		uint8_t *identity, TArray<double> &Luminosity);
 
 	void ReadSheetFont(TArray<FolderEntry> &folderdata, int width, int height, const DVector2 &Scale);
+	void BuildAtlasPage(unsigned page, int which);
 
 	EFontType Type = EFontType::Unknown;
 	int FirstChar, LastChar;
@@ -156,9 +159,13 @@ protected:
 	{
 		FTexture *TranslatedPic = nullptr;	// Texture for use with font translations.
 		FTexture *OriginalPic = nullptr;	// Texture for use with CR_UNTRANSLATED or font colorization. 
+		FTexture *AtlasPic[2] = {};			// Shared atlas textures containing TranslatedPic and OriginalPic
+		float AtlasRect[2][4];				// and the character's position in there (left, top, width, height).
 		int XMove = INT_MIN;
 	};
 	TArray<CharData> Chars;
+	TArray<uint8_t> AtlasPages;				// One bit for each atlas that has been built for a group of characters.
+	TArray<FTexture *> Atlases;				// Removed from the texture manager along with the font.
 	int ActiveColors;
 	TArray<FRemapTable> Ranges;
 	uint8_t PatchRemap[256];
@@ -34,6 +34,7 @@
 */
 
 #include <time.h>
+#include <zlib.h>
 #include "file_zip.h"
 #include "cmdlib.h"
 #include "templates.h"
@@ -109,6 +110,46 @@ bool FCompressedBuffer::Decompress(char *destbuffer)
 	return UncompressZipLump(destbuffer, mr, mMethod, mSize, mCompressedSize, mZipFlags);
 }
 
+//-----------------------------------------------------------------------
+//
+// Deflates a stored buffer in place. If this fails or does not make
+// the data smaller it is left as it is.
+//
+//-----------------------------------------------------------------------
+
+void FCompressedBuffer::Compress()
+{
+	if (mMethod != METHOD_STORED || mSize == 0) return;
+
+	uint8_t *compressbuf = new uint8_t[mSize];
+	z_stream stream;
+	int err;
+
+	stream.next_in = (Bytef *)mBuffer;
+	stream.avail_in = mSize;
+	stream.next_out = (Bytef*)compressbuf;
+	stream.avail_out = mSize;
+	stream.zalloc = (alloc_func)0;
+	stream.zfree = (free_func)0;
+	stream.opaque = (voidpf)0;
+
+	// create output in zip-compatible form
+	err = deflateInit2(&stream, 8, Z_DEFLATED, -15, 9, Z_DEFAULT_STRATEGY);
+	if (err == Z_OK)
+	{
+		err = deflate(&stream, Z_FINISH);
+		if (deflateEnd(&stream) == Z_OK && err == Z_STREAM_END)
+		{
+			delete[] mBuffer;
+			mCompressedSize = stream.total_out;
+			mBuffer = new char[mCompressedSize];
+			mMethod = METHOD_DEFLATE;
+			memcpy(mBuffer, compressbuf, mCompressedSize);
+		}
+	}
+	delete[] compressbuf;
+}
+
 //-----------------------------------------------------------------------
 //
 // Finds the central directory end record in the end of the file.
@@ -19,6 +19,7 @@ struct FCompressedBuffer
 	char *mBuffer;
 
 	bool Decompress(char *destbuffer);
+	void Compress();
 	void Clean()
 	{
 		mSize = mCompressedSize = 0;
@@ -33,6 +33,9 @@
 **
 */
 
+#ifndef NO_SSE
+#include <emmintrin.h>
+#endif
 #include "doomtype.h"
 #include "files.h"
 #include "w_wad.h"
@@ -41,6 +44,8 @@
 #include "bitmap.h"
 #include "imagehelpers.h"
 #include "image.h"
+#include "c_dispatch.h"
+#include "stats.h"
 
 //==========================================================================
 //
@@ -438,6 +443,55 @@ TArray<uint8_t> FPNGTexture::CreatePalettedPixels(int conversion)
 	return Pixels;
 }
 
+//===========================================================================
+//
+// In-place conversions for truecolor images that got decoded straight
+// into the bitmap. These produce the same result as CopyPixelDataRGB
+// does on a freshly created bitmap, which is what all callers pass.
+// That means fully transparent pixels have to end up as 0.
+//
+//===========================================================================
+
+static void ConvertRGBAToBGRA(uint8_t *pixels, int count)
+{
+#ifndef NO_SSE
+	const __m128i agmask = _mm_set1_epi32(0xff00ff00);
+	const __m128i rbmask = _mm_set1_epi32(0x00ff00ff);
+	const __m128i amask = _mm_set1_epi32(0xff000000);
+	for (; count >= 4; count -= 4, pixels += 16)
+	{
+		__m128i p = _mm_loadu_si128((const __m128i *)pixels);
+		__m128i rb = _mm_and_si128(p, rbmask);
+		__m128i result = _mm_or_si128(_mm_and_si128(p, agmask), _mm_or_si128(_mm_srli_epi32(rb, 16), _mm_slli_epi32(rb, 16)));
+		__m128i transparent = _mm_cmpeq_epi32(_mm_and_si128(p, amask), _mm_setzero_si128());
+		_mm_storeu_si128((__m128i *)pixels, _mm_andnot_si128(transparent, result));
+	}
+#endif
+	for (; count > 0; --count, pixels += 4)
+	{
+		if (pixels[3] == 0) memset(pixels, 0, 4);
+		else std::swap(pixels[0], pixels[2]);
+	}
+}
+
+static void ExpandRGBToBGRA(uint8_t *pixels, int width, int height)
+{
+	// Each row holds 3 bytes per pixel at the start of a 4 bytes per pixel row.
+	// Going backward, no pixel gets overwritten before it has been read.
+	for (int y = 0; y < height; y++)
+	{
+		uint8_t *row = pixels + y * width * 4;
+		for (int x = width - 1; x >= 0; x--)
+		{
+			uint8_t r = row[x * 3], g = row[x * 3 + 1], b = row[x * 3 + 2];
+			row[x * 4] = b;
+			row[x * 4 + 1] = g;
+			row[x * 4 + 2] = r;
+			row[x * 4 + 3] = 255;
+		}
+	}
+}
+
 //===========================================================================
 //
 // FPNGTexture::CopyPixels
@@ -511,12 +565,26 @@ int FPNGTexture::CopyPixels(FBitmap *bmp, int conversion)
 		transpal = true;
 	}
 
-	uint8_t * Pixels = new uint8_t[pixwidth * Height];
+	// Truecolor images without a color key can be decoded directly into the bitmap.
+	bool direct = (ColorType == 6 || (ColorType == 2 && !HaveTrans)) &&
+		bmp->GetWidth() == Width && bmp->GetHeight() == Height && bmp->GetPitch() == Width * 4;
+	uint8_t * Pixels = direct ? bmp->GetPixels() : new uint8_t[pixwidth * Height];
 
 	lump->Seek (StartOfIDAT, FileReader::SeekSet);
 	lump->Read(&len, 4);
 	lump->Read(&id, 4);
-	M_ReadIDAT (*lump, Pixels, Width, Height, pixwidth, BitDepth, ColorType, Interlace, BigLong((unsigned int)len));
+	M_ReadIDAT (*lump, Pixels, Width, Height, direct ? Width * 4 : pixwidth, BitDepth, ColorType, Interlace, BigLong((unsigned int)len));
+
+	if (direct)
+	{
+		if (ColorType == 6)
+		{
+			ConvertRGBAToBGRA(Pixels, Width * Height);
+			return -1;
+		}
+		ExpandRGBToBGRA(Pixels, Width, Height);
+		return false;
+	}
 
 	switch (ColorType)
 	{
@@ -683,3 +751,73 @@ FBitmap FPNGFileTexture::GetBgraBitmap(PalEntry *remap, int *trans)
 	}
 	return bmp;
 }
+
+//==========================================================================
+//
+// Decodes all PNGs in the loaded resource files and reports the time.
+// An optional argument limits this to the lumps whose full name starts
+// with it, i.e. a single directory.
+//
+// The image sources are created here instead of going through
+// FImageSource::GetImage so that a lump can never end up being benchmarked
+// as something else. They are kept for the next run because image sources
+// live in an arena and can't be freed individually. The arena gets freed
+// along with the textures, though, so they must be created again after that.
+//
+//==========================================================================
+
+CCMD(benchpng)
+{
+	static TMap<int, FPNGTexture *> images;
+	static int generation = -1;
+
+	if (generation != TexMan.GetGeneration())
+	{
+		images.Clear();
+		generation = TexMan.GetGeneration();
+	}
+
+	const char *prefix = argv.argc() > 1 ? argv[1] : "";
+	size_t prefixlen = strlen(prefix);
+	cycle_t decodetime;
+	int count = 0;
+	double pixels = 0, bytes = 0;
+
+	decodetime.Reset();
+	for (int i = 0; i < Wads.GetNumLumps(); i++)
+	{
+		const char *name = Wads.GetLumpFullName(i);
+		if (prefixlen > 0 && strnicmp(name, prefix, prefixlen)) continue;
+
+		// Don't bother opening anything that's obviously not a PNG. This avoids decompressing entire archives.
+		const char *ext = strrchr(name, '.');
+		if (ext != nullptr && stricmp(ext, ".png")) continue;
+
+		FPNGTexture *img;
+		auto check = images.CheckKey(i);
+		if (check != nullptr)
+		{
+			img = *check;
+		}
+		else
+		{
+			auto reader = Wads.OpenLumpReader(i);
+			img = static_cast<FPNGTexture *>(PNGImage_TryCreate(reader, i));
+			images.Insert(i, img);
+		}
+		if (img == nullptr) continue;
+
+		FBitmap bmp;
+		bmp.Create(img->GetWidth(), img->GetHeight());
+		decodetime.Clock();
+		img->CopyPixels(&bmp, FImageSource::normal);
+		decodetime.Unclock();
+
+		count++;
+		pixels += double(img->GetWidth()) * img->GetHeight();
+		bytes += Wads.LumpLength(i);
+	}
+	double ms = decodetime.TimeMS();
+	Printf("%d PNGs, %.2f MB, %.2f megapixels decoded in %.2f ms (%.2f MP/s)\n", count, bytes / (1024 * 1024), pixels / 1e6, ms,
+		ms > 0 ? pixels / 1e3 / ms : 0.);
+}
@@ -24,6 +24,11 @@
 
 #include <stdlib.h>
 #include <stdint.h>
+#include <string.h>
+#include <vector>
+#ifndef NO_SSE
+#include <emmintrin.h>
+#endif
 
 #define MASK_2     0x0000FF00
 #define MASK_13    0x00FF00FF
@@ -58,6 +63,125 @@ static inline int Diff(uint32_t c1, uint32_t c2)
     return yuv_diff(rgb_to_yuv(c1), rgb_to_yuv(c2));
 }
 
+/* Computes the neighbour difference pattern of every pixel in a row.
+ * prev, cur and next hold the YUV values of the rows above, at and below
+ * the one being scaled and must be readable at index -1 and width.
+ * Bit k of a pattern is set when neighbour k (w1..w9 without w5, in order)
+ * differs from the center pixel. The SSE2 path tests four pixels at once
+ * and gives the same result as calling yuv_diff for each neighbour. */
+static inline void hqx_patterns(const uint32_t *prev, const uint32_t *cur, const uint32_t *next, int width, uint8_t *patterns)
+{
+    int i = 0;
+#ifndef NO_SSE
+    const __m128i ymask = _mm_set1_epi32(Ymask);
+    const __m128i umask = _mm_set1_epi32(Umask);
+    const __m128i vmask = _mm_set1_epi32(Vmask);
+    const __m128i ytr = _mm_set1_epi32(trY);
+    const __m128i utr = _mm_set1_epi32(trU);
+    const __m128i vtr = _mm_set1_epi32(trV);
+
+    for (; i + 4 <= width; i += 4)
+    {
+        const __m128i c = _mm_loadu_si128((const __m128i *)(cur + i));
+        const __m128i cy = _mm_and_si128(c, ymask);
+        const __m128i cu = _mm_and_si128(c, umask);
+        const __m128i cv = _mm_and_si128(c, vmask);
+        __m128i pattern = _mm_setzero_si128();
+
+        auto absdiff = [](__m128i a, __m128i b)
+        {
+            __m128i d = _mm_sub_epi32(a, b);
+            __m128i s = _mm_srai_epi32(d, 31);
+            return _mm_sub_epi32(_mm_xor_si128(d, s), s);
+        };
+        auto test = [&](const uint32_t *n, int flag)
+        {
+            const __m128i w = _mm_loadu_si128((const __m128i *)n);
+            __m128i diff = _mm_cmpgt_epi32(absdiff(_mm_and_si128(w, ymask), cy), ytr);
+            diff = _mm_or_si128(diff, _mm_cmpgt_epi32(absdiff(_mm_and_si128(w, umask), cu), utr));
+            diff = _mm_or_si128(diff, _mm_cmpgt_epi32(absdiff(_mm_and_si128(w, vmask), cv), vtr));
+            pattern = _mm_or_si128(pattern, _mm_and_si128(diff, _mm_set1_epi32(flag)));
+        };
+        test(prev + i - 1, 1);
+        test(prev + i, 2);
+        test(prev + i + 1, 4);
+        test(cur + i - 1, 8);
+        test(cur + i + 1, 16);
+        test(next + i - 1, 32);
+        test(next + i, 64);
+        test(next + i + 1, 128);
+
+        pattern = _mm_packs_epi32(pattern, pattern);
+        pattern = _mm_packus_epi16(pattern, pattern);
+        uint32_t packed = _mm_cvtsi128_si32(pattern);
+        memcpy(patterns + i, &packed, 4);
+    }
+#endif
+    for (; i < width; i++)
+    {
+        const uint32_t c = cur[i];
+        int pattern = 0;
+        if (yuv_diff(c, prev[i - 1])) pattern |= 1;
+        if (yuv_diff(c, prev[i])) pattern |= 2;
+        if (yuv_diff(c, prev[i + 1])) pattern |= 4;
+        if (yuv_diff(c, cur[i - 1])) pattern |= 8;
+        if (yuv_diff(c, cur[i + 1])) pattern |= 16;
+        if (yuv_diff(c, next[i - 1])) pattern |= 32;
+        if (yuv_diff(c, next[i])) pattern |= 64;
+        if (yuv_diff(c, next[i + 1])) pattern |= 128;
+        patterns[i] = (uint8_t)pattern;
+    }
+}
+
+/* Row state shared by the hqNx filters. Every source pixel is converted to
+ * YUV only once and the patterns of a whole row are computed before the
+ * row is scaled. Row r is kept in slot r % 3 with the edge pixels
+ * replicated on both sides, which is how the filters treat the image
+ * border. */
+struct hqx_rows
+{
+    std::vector<uint32_t> yuvbuffer;
+    std::vector<uint8_t> patterns;
+    const uint8_t *src;
+    uint32_t srb;
+    int width, height;
+    const uint32_t *prev, *cur, *next;
+
+    hqx_rows(const uint32_t *sp, uint32_t srb, int width, int height)
+        : yuvbuffer(3 * (width + 2)), patterns(width), src((const uint8_t *)sp), srb(srb), width(width), height(height)
+    {
+        convert(0);
+        if (height > 1) convert(1);
+    }
+
+    uint32_t *slot(int row)
+    {
+        return &yuvbuffer[(row % 3) * (width + 2) + 1];
+    }
+
+    void convert(int row)
+    {
+        const uint32_t *sp = (const uint32_t *)(src + row * srb);
+        uint32_t *yuv = slot(row);
+        for (int i = 0; i < width; i++)
+        {
+            yuv[i] = rgb_to_yuv(sp[i]);
+        }
+        yuv[-1] = yuv[0];
+        yuv[width] = yuv[width - 1];
+    }
+
+    /* Must be called for every row in order, starting at 0. */
+    void setrow(int row)
+    {
+        if (row > 0 && row + 1 < height) convert(row + 1);
+        prev = slot(row > 0 ? row - 1 : row);
+        cur = slot(row);
+        next = slot(row + 1 < height ? row + 1 : row);
+        hqx_patterns(prev, cur, next, width, patterns.data());
+    }
+};
+
 /* Interpolate functions */
 static inline uint32_t Interpolate_2(uint32_t c1, int w1, uint32_t c2, int w2, int s)
 {
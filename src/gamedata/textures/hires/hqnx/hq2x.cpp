@@ -72,14 +72,15 @@
 
 HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp, uint32_t drb, int Xres, int Yres )
 {
-    int  i, j, k;
+    int  i, j;
     int  prevline, nextline;
     uint32_t  w[10];
     int dpL = (drb >> 2);
     int spL = (srb >> 2);
     uint8_t *sRowP = (uint8_t *) sp;
     uint8_t *dRowP = (uint8_t *) dp;
-    uint32_t yuv1, yuv2;
+    uint32_t  yw[10];
+    hqx_rows rows(sp, srb, Xres, Yres);
 
     //   +----+----+----+
     //   |    |    |    |
@@ -94,6 +95,8 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
 
     for (j=0; j<Yres; j++)
     {
+        rows.setrow(j);
+
         if (j>0)      prevline = -spL; else prevline = 0;
         if (j<Yres-1) nextline =  spL; else nextline = 0;
 
@@ -129,23 +132,12 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 w[9] = w[8];
             }
 
-            int pattern = 0;
-            int flag = 1;
-
-            yuv1 = rgb_to_yuv(w[5]);
+            int pattern = rows.patterns[i];
 
-            for (k=1; k<=9; k++)
-            {
-                if (k==5) continue;
-
-                if ( w[k] != w[5] )
-                {
-                    yuv2 = rgb_to_yuv(w[k]);
-                    if (yuv_diff(yuv1, yuv2))
-                        pattern |= flag;
-                }
-                flag <<= 1;
-            }
+            yw[2] = rows.prev[i];
+            yw[4] = rows.cur[i - 1];
+            yw[6] = rows.cur[i + 1];
+            yw[8] = rows.next[i];
 
             switch (pattern)
             {
@@ -308,7 +300,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 50:
                     {
                         PIXEL00_22
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_10
                         }
@@ -326,7 +318,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL00_20
                         PIXEL01_22
                         PIXEL10_21
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_10
                         }
@@ -341,7 +333,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_21
                         PIXEL01_20
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_10
                         }
@@ -355,7 +347,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 10:
                 case 138:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_10
                         }
@@ -428,7 +420,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 54:
                     {
                         PIXEL00_22
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_0
                         }
@@ -446,7 +438,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL00_20
                         PIXEL01_22
                         PIXEL10_21
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_0
                         }
@@ -461,7 +453,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_21
                         PIXEL01_20
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_0
                         }
@@ -475,7 +467,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 11:
                 case 139:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                         }
@@ -491,7 +483,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 19:
                 case 51:
                     {
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL00_11
                             PIXEL01_10
@@ -509,7 +501,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 178:
                     {
                         PIXEL00_22
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_10
                             PIXEL11_12
@@ -526,7 +518,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 85:
                     {
                         PIXEL00_20
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL01_11
                             PIXEL11_10
@@ -544,7 +536,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_20
                         PIXEL01_22
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL10_12
                             PIXEL11_10
@@ -561,7 +553,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_21
                         PIXEL01_20
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_10
                             PIXEL11_11
@@ -576,7 +568,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 73:
                 case 77:
                     {
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL00_12
                             PIXEL10_10
@@ -593,7 +585,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 42:
                 case 170:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_10
                             PIXEL10_11
@@ -610,7 +602,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 14:
                 case 142:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_10
                             PIXEL01_12
@@ -691,7 +683,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 26:
                 case 31:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                         }
@@ -699,7 +691,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_20
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_0
                         }
@@ -715,7 +707,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 214:
                     {
                         PIXEL00_22
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_0
                         }
@@ -724,7 +716,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL01_20
                         }
                         PIXEL10_21
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_0
                         }
@@ -739,7 +731,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_21
                         PIXEL01_22
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_0
                         }
@@ -747,7 +739,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_20
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_0
                         }
@@ -760,7 +752,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 74:
                 case 107:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                         }
@@ -769,7 +761,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_20
                         }
                         PIXEL01_21
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_0
                         }
@@ -782,7 +774,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 27:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                         }
@@ -798,7 +790,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 86:
                     {
                         PIXEL00_22
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_0
                         }
@@ -815,7 +807,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL00_21
                         PIXEL01_22
                         PIXEL10_10
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_0
                         }
@@ -829,7 +821,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_10
                         PIXEL01_21
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_0
                         }
@@ -843,7 +835,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 30:
                     {
                         PIXEL00_10
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_0
                         }
@@ -860,7 +852,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL00_22
                         PIXEL01_10
                         PIXEL10_21
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_0
                         }
@@ -874,7 +866,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_21
                         PIXEL01_22
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_0
                         }
@@ -887,7 +879,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 75:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                         }
@@ -998,7 +990,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 58:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_10
                         }
@@ -1006,7 +998,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_70
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_10
                         }
@@ -1021,7 +1013,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 83:
                     {
                         PIXEL00_11
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_10
                         }
@@ -1030,7 +1022,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL01_70
                         }
                         PIXEL10_21
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_10
                         }
@@ -1044,7 +1036,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_21
                         PIXEL01_11
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_10
                         }
@@ -1052,7 +1044,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_70
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_10
                         }
@@ -1064,7 +1056,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 202:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_10
                         }
@@ -1073,7 +1065,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_70
                         }
                         PIXEL01_21
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_10
                         }
@@ -1086,7 +1078,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 78:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_10
                         }
@@ -1095,7 +1087,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_70
                         }
                         PIXEL01_12
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_10
                         }
@@ -1108,7 +1100,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 154:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_10
                         }
@@ -1116,7 +1108,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_70
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_10
                         }
@@ -1131,7 +1123,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 114:
                     {
                         PIXEL00_22
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_10
                         }
@@ -1140,7 +1132,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL01_70
                         }
                         PIXEL10_12
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_10
                         }
@@ -1154,7 +1146,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_12
                         PIXEL01_22
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_10
                         }
@@ -1162,7 +1154,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_70
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_10
                         }
@@ -1174,7 +1166,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 90:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_10
                         }
@@ -1182,7 +1174,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_70
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_10
                         }
@@ -1190,7 +1182,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL01_70
                         }
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_10
                         }
@@ -1198,7 +1190,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_70
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_10
                         }
@@ -1211,7 +1203,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 55:
                 case 23:
                     {
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL00_11
                             PIXEL01_0
@@ -1229,7 +1221,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 150:
                     {
                         PIXEL00_22
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_0
                             PIXEL11_12
@@ -1246,7 +1238,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 212:
                     {
                         PIXEL00_20
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL01_11
                             PIXEL11_0
@@ -1264,7 +1256,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_20
                         PIXEL01_22
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL10_12
                             PIXEL11_0
@@ -1281,7 +1273,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_21
                         PIXEL01_20
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_0
                             PIXEL11_11
@@ -1296,7 +1288,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 109:
                 case 105:
                     {
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL00_12
                             PIXEL10_0
@@ -1313,7 +1305,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 171:
                 case 43:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                             PIXEL10_11
@@ -1330,7 +1322,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 143:
                 case 15:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                             PIXEL01_12
@@ -1348,7 +1340,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_21
                         PIXEL01_11
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_0
                         }
@@ -1361,7 +1353,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 203:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                         }
@@ -1377,7 +1369,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 62:
                     {
                         PIXEL00_10
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_0
                         }
@@ -1394,7 +1386,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL00_11
                         PIXEL01_10
                         PIXEL10_21
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_0
                         }
@@ -1407,7 +1399,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 118:
                     {
                         PIXEL00_22
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_0
                         }
@@ -1424,7 +1416,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL00_12
                         PIXEL01_22
                         PIXEL10_10
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_0
                         }
@@ -1438,7 +1430,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_10
                         PIXEL01_12
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_0
                         }
@@ -1451,7 +1443,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 155:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                         }
@@ -1532,7 +1524,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_21
                         PIXEL01_11
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_10
                         }
@@ -1540,7 +1532,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_70
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_0
                         }
@@ -1552,7 +1544,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 158:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_10
                         }
@@ -1560,7 +1552,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_70
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_0
                         }
@@ -1574,7 +1566,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 234:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_10
                         }
@@ -1583,7 +1575,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_70
                         }
                         PIXEL01_21
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_0
                         }
@@ -1597,7 +1589,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 242:
                     {
                         PIXEL00_22
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_10
                         }
@@ -1606,7 +1598,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL01_70
                         }
                         PIXEL10_12
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_0
                         }
@@ -1618,7 +1610,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 59:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                         }
@@ -1626,7 +1618,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_20
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_10
                         }
@@ -1642,7 +1634,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_12
                         PIXEL01_22
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_0
                         }
@@ -1650,7 +1642,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_20
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_10
                         }
@@ -1663,7 +1655,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 87:
                     {
                         PIXEL00_11
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_0
                         }
@@ -1672,7 +1664,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL01_20
                         }
                         PIXEL10_21
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_10
                         }
@@ -1684,7 +1676,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 79:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                         }
@@ -1693,7 +1685,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_20
                         }
                         PIXEL01_12
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_10
                         }
@@ -1706,7 +1698,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 122:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_10
                         }
@@ -1714,7 +1706,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_70
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_10
                         }
@@ -1722,7 +1714,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL01_70
                         }
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_0
                         }
@@ -1730,7 +1722,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_20
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_10
                         }
@@ -1742,7 +1734,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 94:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_10
                         }
@@ -1750,7 +1742,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_70
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_0
                         }
@@ -1758,7 +1750,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL01_20
                         }
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_10
                         }
@@ -1766,7 +1758,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_70
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_10
                         }
@@ -1778,7 +1770,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 218:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_10
                         }
@@ -1786,7 +1778,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_70
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_10
                         }
@@ -1794,7 +1786,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL01_70
                         }
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_10
                         }
@@ -1802,7 +1794,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_70
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_0
                         }
@@ -1814,7 +1806,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 91:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                         }
@@ -1822,7 +1814,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_20
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_10
                         }
@@ -1830,7 +1822,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL01_70
                         }
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_10
                         }
@@ -1838,7 +1830,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_70
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_10
                         }
@@ -1882,7 +1874,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 186:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_10
                         }
@@ -1890,7 +1882,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_70
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_10
                         }
@@ -1905,7 +1897,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 115:
                     {
                         PIXEL00_11
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_10
                         }
@@ -1914,7 +1906,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL01_70
                         }
                         PIXEL10_12
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_10
                         }
@@ -1928,7 +1920,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_12
                         PIXEL01_11
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_10
                         }
@@ -1936,7 +1928,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_70
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_10
                         }
@@ -1948,7 +1940,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 206:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_10
                         }
@@ -1957,7 +1949,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_70
                         }
                         PIXEL01_12
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_10
                         }
@@ -1973,7 +1965,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_12
                         PIXEL01_20
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_10
                         }
@@ -1987,7 +1979,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 174:
                 case 46:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_10
                         }
@@ -2004,7 +1996,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 147:
                     {
                         PIXEL00_11
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_10
                         }
@@ -2022,7 +2014,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL00_20
                         PIXEL01_11
                         PIXEL10_12
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_10
                         }
@@ -2051,7 +2043,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 126:
                     {
                         PIXEL00_10
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_0
                         }
@@ -2059,7 +2051,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL01_20
                         }
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_0
                         }
@@ -2072,7 +2064,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 219:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                         }
@@ -2082,7 +2074,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         }
                         PIXEL01_10
                         PIXEL10_10
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_0
                         }
@@ -2094,7 +2086,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 125:
                     {
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL00_12
                             PIXEL10_0
@@ -2111,7 +2103,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 221:
                     {
                         PIXEL00_12
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL01_11
                             PIXEL11_0
@@ -2126,7 +2118,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 207:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                             PIXEL01_12
@@ -2144,7 +2136,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_10
                         PIXEL01_12
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_0
                             PIXEL11_11
@@ -2159,7 +2151,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 190:
                     {
                         PIXEL00_10
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_0
                             PIXEL11_12
@@ -2174,7 +2166,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 187:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                             PIXEL10_11
@@ -2192,7 +2184,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_11
                         PIXEL01_10
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL10_12
                             PIXEL11_0
@@ -2206,7 +2198,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 119:
                     {
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL00_11
                             PIXEL01_0
@@ -2225,7 +2217,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_12
                         PIXEL01_20
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_0
                         }
@@ -2239,7 +2231,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 175:
                 case 47:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                         }
@@ -2256,7 +2248,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 151:
                     {
                         PIXEL00_11
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_0
                         }
@@ -2274,7 +2266,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL00_20
                         PIXEL01_11
                         PIXEL10_12
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_0
                         }
@@ -2288,7 +2280,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_10
                         PIXEL01_10
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_0
                         }
@@ -2296,7 +2288,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_20
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_0
                         }
@@ -2308,7 +2300,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 123:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                         }
@@ -2317,7 +2309,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_20
                         }
                         PIXEL01_10
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_0
                         }
@@ -2330,7 +2322,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 95:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                         }
@@ -2338,7 +2330,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_20
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_0
                         }
@@ -2353,7 +2345,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 222:
                     {
                         PIXEL00_10
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_0
                         }
@@ -2362,7 +2354,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL01_20
                         }
                         PIXEL10_10
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_0
                         }
@@ -2376,7 +2368,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_21
                         PIXEL01_11
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_0
                         }
@@ -2384,7 +2376,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_20
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_0
                         }
@@ -2398,7 +2390,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_12
                         PIXEL01_22
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_0
                         }
@@ -2406,7 +2398,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_100
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_0
                         }
@@ -2418,7 +2410,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 235:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                         }
@@ -2427,7 +2419,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_20
                         }
                         PIXEL01_21
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_0
                         }
@@ -2440,7 +2432,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 111:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                         }
@@ -2449,7 +2441,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_100
                         }
                         PIXEL01_12
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_0
                         }
@@ -2462,7 +2454,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 63:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                         }
@@ -2470,7 +2462,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_100
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_0
                         }
@@ -2484,7 +2476,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 159:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                         }
@@ -2492,7 +2484,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_20
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_0
                         }
@@ -2507,7 +2499,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 215:
                     {
                         PIXEL00_11
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_0
                         }
@@ -2516,7 +2508,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL01_100
                         }
                         PIXEL10_21
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_0
                         }
@@ -2529,7 +2521,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 246:
                     {
                         PIXEL00_22
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_0
                         }
@@ -2538,7 +2530,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL01_20
                         }
                         PIXEL10_12
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_0
                         }
@@ -2551,7 +2543,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 254:
                     {
                         PIXEL00_10
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_0
                         }
@@ -2559,7 +2551,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL01_20
                         }
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_0
                         }
@@ -2567,7 +2559,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_20
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_0
                         }
@@ -2581,7 +2573,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_12
                         PIXEL01_11
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_0
                         }
@@ -2589,7 +2581,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_100
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_0
                         }
@@ -2601,7 +2593,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 251:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                         }
@@ -2610,7 +2602,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_20
                         }
                         PIXEL01_10
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_0
                         }
@@ -2618,7 +2610,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_100
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_0
                         }
@@ -2630,7 +2622,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 239:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                         }
@@ -2639,7 +2631,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_100
                         }
                         PIXEL01_12
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_0
                         }
@@ -2652,7 +2644,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 127:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                         }
@@ -2660,7 +2652,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_100
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_0
                         }
@@ -2668,7 +2660,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL01_20
                         }
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_0
                         }
@@ -2681,7 +2673,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 191:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                         }
@@ -2689,7 +2681,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_100
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_0
                         }
@@ -2703,7 +2695,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 223:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                         }
@@ -2711,7 +2703,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_20
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_0
                         }
@@ -2720,7 +2712,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL01_100
                         }
                         PIXEL10_10
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_0
                         }
@@ -2733,7 +2725,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 247:
                     {
                         PIXEL00_11
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_0
                         }
@@ -2742,7 +2734,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL01_100
                         }
                         PIXEL10_12
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_0
                         }
@@ -2754,7 +2746,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 255:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                         }
@@ -2762,7 +2754,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_100
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_0
                         }
@@ -2770,7 +2762,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL01_100
                         }
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_0
                         }
@@ -2778,7 +2770,7 @@ HQX_API void HQX_CALLCONV hq2x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL10_100
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL11_0
                         }
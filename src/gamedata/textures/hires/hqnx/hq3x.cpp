@@ -77,14 +77,15 @@
 
 HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp, uint32_t drb, int Xres, int Yres )
 {
-    int  i, j, k;
+    int  i, j;
     int  prevline, nextline;
     uint32_t  w[10];
     int dpL = (drb >> 2);
     int spL = (srb >> 2);
     uint8_t *sRowP = (uint8_t *) sp;
     uint8_t *dRowP = (uint8_t *) dp;
-    uint32_t yuv1, yuv2;
+    uint32_t  yw[10];
+    hqx_rows rows(sp, srb, Xres, Yres);
 
     //   +----+----+----+
     //   |    |    |    |
@@ -99,6 +100,8 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
 
     for (j=0; j<Yres; j++)
     {
+        rows.setrow(j);
+
         if (j>0)      prevline = -spL; else prevline = 0;
         if (j<Yres-1) nextline =  spL; else nextline = 0;
 
@@ -134,23 +137,12 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 w[9] = w[8];
             }
 
-            int pattern = 0;
-            int flag = 1;
-
-            yuv1 = rgb_to_yuv(w[5]);
+            int pattern = rows.patterns[i];
 
-            for (k=1; k<=9; k++)
-            {
-                if (k==5) continue;
-
-                if ( w[k] != w[5] )
-                {
-                    yuv2 = rgb_to_yuv(w[k]);
-                    if (yuv_diff(yuv1, yuv2))
-                        pattern |= flag;
-                }
-                flag <<= 1;
-            }
+            yw[2] = rows.prev[i];
+            yw[4] = rows.cur[i - 1];
+            yw[6] = rows.cur[i + 1];
+            yw[8] = rows.next[i];
 
             switch (pattern)
             {
@@ -378,7 +370,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 50:
                     {
                         PIXEL00_1M
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_C
                             PIXEL02_1M
@@ -406,7 +398,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_1
                         PIXEL11
                         PIXEL20_1M
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -428,7 +420,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL02_2
                         PIXEL11
                         PIXEL12_1
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_C
                             PIXEL20_1M
@@ -446,7 +438,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 10:
                 case 138:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_1M
                             PIXEL01_C
@@ -556,7 +548,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 54:
                     {
                         PIXEL00_1M
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -584,7 +576,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_1
                         PIXEL11
                         PIXEL20_1M
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -606,7 +598,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL02_2
                         PIXEL11
                         PIXEL12_1
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -624,7 +616,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 11:
                 case 139:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -647,7 +639,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 19:
                 case 51:
                     {
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL00_1L
                             PIXEL01_C
@@ -671,7 +663,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 146:
                 case 178:
                     {
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_C
                             PIXEL02_1M
@@ -695,7 +687,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 84:
                 case 85:
                     {
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL02_1U
                             PIXEL12_C
@@ -719,7 +711,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 112:
                 case 113:
                     {
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL12_C
                             PIXEL20_1L
@@ -743,7 +735,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 200:
                 case 204:
                     {
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_C
                             PIXEL20_1M
@@ -767,7 +759,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 73:
                 case 77:
                     {
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL00_1U
                             PIXEL10_C
@@ -791,7 +783,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 42:
                 case 170:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_1M
                             PIXEL01_C
@@ -815,7 +807,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 14:
                 case 142:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_1M
                             PIXEL01_C
@@ -943,7 +935,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 26:
                 case 31:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_C
                             PIXEL10_C
@@ -954,7 +946,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL10_3
                         }
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_C
                             PIXEL12_C
@@ -974,7 +966,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 214:
                     {
                         PIXEL00_1M
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -988,7 +980,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11
                         PIXEL12_C
                         PIXEL20_1M
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL21_C
                             PIXEL22_C
@@ -1007,7 +999,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL01_1
                         PIXEL02_1M
                         PIXEL11
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -1018,7 +1010,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL20_4
                         }
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL12_C
                             PIXEL22_C
@@ -1033,7 +1025,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 74:
                 case 107:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -1047,7 +1039,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_1
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_C
                             PIXEL21_C
@@ -1062,7 +1054,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 27:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -1085,7 +1077,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 86:
                     {
                         PIXEL00_1M
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -1112,7 +1104,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL20_1M
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -1133,7 +1125,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL02_1M
                         PIXEL11
                         PIXEL12_1
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -1151,7 +1143,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 30:
                     {
                         PIXEL00_1M
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -1178,7 +1170,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_1
                         PIXEL11
                         PIXEL20_1M
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -1199,7 +1191,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL02_1M
                         PIXEL11
                         PIXEL12_C
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -1216,7 +1208,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 75:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -1394,7 +1386,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 58:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_1M
                         }
@@ -1403,7 +1395,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_2
                         }
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_1M
                         }
@@ -1423,7 +1415,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_1L
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_1M
                         }
@@ -1436,7 +1428,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL12_C
                         PIXEL20_1M
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_1M
                         }
@@ -1454,7 +1446,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_C
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_1M
                         }
@@ -1463,7 +1455,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL20_2
                         }
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_1M
                         }
@@ -1475,7 +1467,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 202:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_1M
                         }
@@ -1488,7 +1480,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_1
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_1M
                         }
@@ -1502,7 +1494,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 78:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_1M
                         }
@@ -1515,7 +1507,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_1
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_1M
                         }
@@ -1529,7 +1521,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 154:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_1M
                         }
@@ -1538,7 +1530,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_2
                         }
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_1M
                         }
@@ -1558,7 +1550,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_1M
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_1M
                         }
@@ -1571,7 +1563,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL12_C
                         PIXEL20_1L
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_1M
                         }
@@ -1589,7 +1581,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_C
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_1M
                         }
@@ -1598,7 +1590,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL20_2
                         }
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_1M
                         }
@@ -1610,7 +1602,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 90:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_1M
                         }
@@ -1619,7 +1611,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_2
                         }
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_1M
                         }
@@ -1630,7 +1622,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_C
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_1M
                         }
@@ -1639,7 +1631,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL20_2
                         }
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_1M
                         }
@@ -1652,7 +1644,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 55:
                 case 23:
                     {
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL00_1L
                             PIXEL01_C
@@ -1676,7 +1668,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 182:
                 case 150:
                     {
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -1700,7 +1692,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 213:
                 case 212:
                     {
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL02_1U
                             PIXEL12_C
@@ -1724,7 +1716,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 241:
                 case 240:
                     {
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL12_C
                             PIXEL20_1L
@@ -1748,7 +1740,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 236:
                 case 232:
                     {
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -1772,7 +1764,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 109:
                 case 105:
                     {
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL00_1U
                             PIXEL10_C
@@ -1796,7 +1788,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 171:
                 case 43:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -1820,7 +1812,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 143:
                 case 15:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -1848,7 +1840,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL02_1U
                         PIXEL11
                         PIXEL12_C
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -1865,7 +1857,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 203:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -1888,7 +1880,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 62:
                     {
                         PIXEL00_1M
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -1915,7 +1907,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_1
                         PIXEL11
                         PIXEL20_1M
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -1932,7 +1924,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 118:
                     {
                         PIXEL00_1M
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -1959,7 +1951,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL20_1M
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -1980,7 +1972,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL02_1R
                         PIXEL11
                         PIXEL12_1
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -1997,7 +1989,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 155:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -2128,7 +2120,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL02_1U
                         PIXEL10_C
                         PIXEL11
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_1M
                         }
@@ -2136,7 +2128,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL20_2
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -2152,7 +2144,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 158:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_1M
                         }
@@ -2160,7 +2152,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_2
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -2181,7 +2173,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 234:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_1M
                         }
@@ -2193,7 +2185,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL02_1M
                         PIXEL11
                         PIXEL12_1
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -2212,7 +2204,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_1M
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_1M
                         }
@@ -2223,7 +2215,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_1
                         PIXEL11
                         PIXEL20_1L
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -2239,7 +2231,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 59:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -2251,7 +2243,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL01_3
                             PIXEL10_3
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_1M
                         }
@@ -2273,7 +2265,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL02_1M
                         PIXEL11
                         PIXEL12_C
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -2285,7 +2277,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL20_4
                             PIXEL21_3
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_1M
                         }
@@ -2298,7 +2290,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 87:
                     {
                         PIXEL00_1L
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -2314,7 +2306,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11
                         PIXEL20_1M
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_1M
                         }
@@ -2326,7 +2318,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 79:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -2341,7 +2333,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL02_1R
                         PIXEL11
                         PIXEL12_1
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_1M
                         }
@@ -2355,7 +2347,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 122:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_1M
                         }
@@ -2364,7 +2356,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_2
                         }
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_1M
                         }
@@ -2374,7 +2366,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         }
                         PIXEL11
                         PIXEL12_C
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -2386,7 +2378,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL20_4
                             PIXEL21_3
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_1M
                         }
@@ -2398,7 +2390,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 94:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_1M
                         }
@@ -2406,7 +2398,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL00_2
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -2420,7 +2412,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         }
                         PIXEL10_C
                         PIXEL11
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_1M
                         }
@@ -2429,7 +2421,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL20_2
                         }
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_1M
                         }
@@ -2441,7 +2433,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 218:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_1M
                         }
@@ -2450,7 +2442,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_2
                         }
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_1M
                         }
@@ -2460,7 +2452,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         }
                         PIXEL10_C
                         PIXEL11
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_1M
                         }
@@ -2468,7 +2460,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         {
                             PIXEL20_2
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -2484,7 +2476,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 91:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -2496,7 +2488,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL01_3
                             PIXEL10_3
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_1M
                         }
@@ -2506,7 +2498,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         }
                         PIXEL11
                         PIXEL12_C
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_1M
                         }
@@ -2515,7 +2507,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL20_2
                         }
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_1M
                         }
@@ -2579,7 +2571,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 186:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_1M
                         }
@@ -2588,7 +2580,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_2
                         }
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_1M
                         }
@@ -2608,7 +2600,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_1L
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_1M
                         }
@@ -2621,7 +2613,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL12_C
                         PIXEL20_1L
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_1M
                         }
@@ -2639,7 +2631,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_C
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_1M
                         }
@@ -2648,7 +2640,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL20_2
                         }
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_1M
                         }
@@ -2660,7 +2652,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 206:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_1M
                         }
@@ -2673,7 +2665,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_1
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_1M
                         }
@@ -2694,7 +2686,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_1
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_1M
                         }
@@ -2709,7 +2701,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 174:
                 case 46:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_1M
                         }
@@ -2732,7 +2724,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_1L
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_1M
                         }
@@ -2759,7 +2751,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL12_C
                         PIXEL20_1L
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_1M
                         }
@@ -2798,7 +2790,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 126:
                     {
                         PIXEL00_1M
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -2811,7 +2803,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL12_3
                         }
                         PIXEL11
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -2828,7 +2820,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 219:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -2843,7 +2835,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL02_1M
                         PIXEL11
                         PIXEL20_1M
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -2859,7 +2851,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 125:
                     {
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL00_1U
                             PIXEL10_C
@@ -2882,7 +2874,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 221:
                     {
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL02_1U
                             PIXEL12_C
@@ -2905,7 +2897,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 207:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -2928,7 +2920,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 238:
                     {
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -2951,7 +2943,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 190:
                     {
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -2974,7 +2966,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 187:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -2997,7 +2989,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 243:
                     {
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL12_C
                             PIXEL20_1L
@@ -3020,7 +3012,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 119:
                     {
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL00_1L
                             PIXEL01_C
@@ -3050,7 +3042,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_1
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_C
                         }
@@ -3065,7 +3057,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 175:
                 case 47:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_C
                         }
@@ -3088,7 +3080,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_1L
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_C
                         }
@@ -3115,7 +3107,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL12_C
                         PIXEL20_1L
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_C
                         }
@@ -3131,7 +3123,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL01_C
                         PIXEL02_1M
                         PIXEL11
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -3142,7 +3134,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL20_4
                         }
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL12_C
                             PIXEL22_C
@@ -3156,7 +3148,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 123:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -3170,7 +3162,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_C
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_C
                             PIXEL21_C
@@ -3185,7 +3177,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 95:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_C
                             PIXEL10_C
@@ -3196,7 +3188,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL10_3
                         }
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_C
                             PIXEL12_C
@@ -3215,7 +3207,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 222:
                     {
                         PIXEL00_1M
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -3229,7 +3221,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11
                         PIXEL12_C
                         PIXEL20_1M
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL21_C
                             PIXEL22_C
@@ -3248,7 +3240,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL02_1U
                         PIXEL11
                         PIXEL12_C
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -3259,7 +3251,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL20_4
                         }
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_C
                         }
@@ -3276,7 +3268,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL02_1M
                         PIXEL10_C
                         PIXEL11
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_C
                         }
@@ -3285,7 +3277,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL20_2
                         }
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL12_C
                             PIXEL22_C
@@ -3299,7 +3291,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 235:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -3313,7 +3305,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_1
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_C
                         }
@@ -3327,7 +3319,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 111:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_C
                         }
@@ -3340,7 +3332,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_1
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_C
                             PIXEL21_C
@@ -3355,7 +3347,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 63:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_C
                         }
@@ -3364,7 +3356,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_2
                         }
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_C
                             PIXEL12_C
@@ -3383,7 +3375,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 159:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_C
                             PIXEL10_C
@@ -3394,7 +3386,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL10_3
                         }
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_C
                         }
@@ -3413,7 +3405,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_1L
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_C
                         }
@@ -3425,7 +3417,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11
                         PIXEL12_C
                         PIXEL20_1M
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL21_C
                             PIXEL22_C
@@ -3440,7 +3432,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 246:
                     {
                         PIXEL00_1M
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -3455,7 +3447,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL12_C
                         PIXEL20_1L
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_C
                         }
@@ -3468,7 +3460,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 254:
                     {
                         PIXEL00_1M
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -3479,7 +3471,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL02_4
                         }
                         PIXEL11
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -3489,7 +3481,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL10_3
                             PIXEL20_4
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL12_C
                             PIXEL21_C
@@ -3511,7 +3503,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_C
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_C
                         }
@@ -3520,7 +3512,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL20_2
                         }
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_C
                         }
@@ -3532,7 +3524,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 251:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -3544,7 +3536,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         }
                         PIXEL02_1M
                         PIXEL11
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL10_C
                             PIXEL20_C
@@ -3556,7 +3548,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL20_2
                             PIXEL21_3
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL12_C
                             PIXEL22_C
@@ -3570,7 +3562,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 239:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_C
                         }
@@ -3583,7 +3575,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_1
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_C
                         }
@@ -3597,7 +3589,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 127:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_C
                             PIXEL01_C
@@ -3609,7 +3601,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL01_3
                             PIXEL10_3
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_C
                             PIXEL12_C
@@ -3620,7 +3612,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL12_3
                         }
                         PIXEL11
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_C
                             PIXEL21_C
@@ -3635,7 +3627,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 191:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_C
                         }
@@ -3644,7 +3636,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_2
                         }
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_C
                         }
@@ -3662,7 +3654,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 223:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_C
                             PIXEL10_C
@@ -3672,7 +3664,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_4
                             PIXEL10_3
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL01_C
                             PIXEL02_C
@@ -3686,7 +3678,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         }
                         PIXEL11
                         PIXEL20_1M
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL21_C
                             PIXEL22_C
@@ -3702,7 +3694,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_1L
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_C
                         }
@@ -3715,7 +3707,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL12_C
                         PIXEL20_1L
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_C
                         }
@@ -3727,7 +3719,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 255:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_C
                         }
@@ -3736,7 +3728,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_2
                         }
                         PIXEL01_C
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_C
                         }
@@ -3747,7 +3739,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_C
                         PIXEL11
                         PIXEL12_C
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_C
                         }
@@ -3756,7 +3748,7 @@ HQX_API void HQX_CALLCONV hq3x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL20_2
                         }
                         PIXEL21_C
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_C
                         }
@@ -164,14 +164,15 @@
 
 HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp, uint32_t drb, int Xres, int Yres )
 {
-    int  i, j, k;
+    int  i, j;
     int  prevline, nextline;
     uint32_t w[10];
     int dpL = (drb >> 2);
     int spL = (srb >> 2);
     uint8_t *sRowP = (uint8_t *) sp;
     uint8_t *dRowP = (uint8_t *) dp;
-    uint32_t yuv1, yuv2;
+    uint32_t  yw[10];
+    hqx_rows rows(sp, srb, Xres, Yres);
 
     //   +----+----+----+
     //   |    |    |    |
@@ -186,6 +187,8 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
 
     for (j=0; j<Yres; j++)
     {
+        rows.setrow(j);
+
         if (j>0)      prevline = -spL; else prevline = 0;
         if (j<Yres-1) nextline =  spL; else nextline = 0;
 
@@ -221,23 +224,12 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 w[9] = w[8];
             }
 
-            int pattern = 0;
-            int flag = 1;
-
-            yuv1 = rgb_to_yuv(w[5]);
+            int pattern = rows.patterns[i];
 
-            for (k=1; k<=9; k++)
-            {
-                if (k==5) continue;
-
-                if ( w[k] != w[5] )
-                {
-                    yuv2 = rgb_to_yuv(w[k]);
-                    if (yuv_diff(yuv1, yuv2))
-                        pattern |= flag;
-                }
-                flag <<= 1;
-            }
+            yw[2] = rows.prev[i];
+            yw[4] = rows.cur[i - 1];
+            yw[6] = rows.cur[i + 1];
+            yw[8] = rows.next[i];
 
             switch (pattern)
             {
@@ -557,7 +549,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_80
                         PIXEL01_10
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_10
                             PIXEL03_80
@@ -596,7 +588,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL13_10
                         PIXEL20_61
                         PIXEL21_30
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_30
                             PIXEL23_10
@@ -625,7 +617,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11_30
                         PIXEL12_70
                         PIXEL13_60
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_10
                             PIXEL21_30
@@ -648,7 +640,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 10:
                 case 138:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_80
                             PIXEL01_10
@@ -809,7 +801,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_80
                         PIXEL01_10
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -848,7 +840,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL20_61
                         PIXEL21_30
                         PIXEL22_0
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -875,7 +867,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11_30
                         PIXEL12_70
                         PIXEL13_60
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -897,7 +889,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 11:
                 case 139:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -927,7 +919,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 19:
                 case 51:
                     {
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL00_81
                             PIXEL01_31
@@ -962,7 +954,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_80
                         PIXEL01_10
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_10
                             PIXEL03_80
@@ -996,7 +988,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL00_20
                         PIXEL01_60
                         PIXEL02_81
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL03_81
                             PIXEL13_31
@@ -1036,7 +1028,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL13_10
                         PIXEL20_82
                         PIXEL21_32
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_30
                             PIXEL23_10
@@ -1067,7 +1059,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11_30
                         PIXEL12_70
                         PIXEL13_60
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_10
                             PIXEL21_30
@@ -1092,7 +1084,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 73:
                 case 77:
                     {
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL00_82
                             PIXEL10_32
@@ -1125,7 +1117,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 42:
                 case 170:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_80
                             PIXEL01_10
@@ -1158,7 +1150,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 14:
                 case 142:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_80
                             PIXEL01_10
@@ -1351,7 +1343,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 26:
                 case 31:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -1363,7 +1355,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL01_50
                             PIXEL10_50
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -1392,7 +1384,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_80
                         PIXEL01_10
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -1410,7 +1402,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL20_61
                         PIXEL21_30
                         PIXEL22_0
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -1437,7 +1429,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11_30
                         PIXEL12_30
                         PIXEL13_10
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -1451,7 +1443,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         }
                         PIXEL21_0
                         PIXEL22_0
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -1468,7 +1460,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 74:
                 case 107:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -1485,7 +1477,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11_0
                         PIXEL12_30
                         PIXEL13_61
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -1506,7 +1498,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 27:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -1537,7 +1529,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_80
                         PIXEL01_10
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -1575,7 +1567,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL20_10
                         PIXEL21_30
                         PIXEL22_0
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -1601,7 +1593,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11_30
                         PIXEL12_30
                         PIXEL13_61
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -1624,7 +1616,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_80
                         PIXEL01_10
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -1662,7 +1654,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL20_61
                         PIXEL21_30
                         PIXEL22_0
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -1688,7 +1680,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11_30
                         PIXEL12_30
                         PIXEL13_10
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -1709,7 +1701,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 75:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -1978,7 +1970,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 58:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_80
                             PIXEL01_10
@@ -1992,7 +1984,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL10_11
                             PIXEL11_0
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_10
                             PIXEL03_80
@@ -2020,7 +2012,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_81
                         PIXEL01_31
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_10
                             PIXEL03_80
@@ -2038,7 +2030,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11_31
                         PIXEL20_61
                         PIXEL21_30
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_30
                             PIXEL23_10
@@ -2066,7 +2058,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11_30
                         PIXEL12_31
                         PIXEL13_31
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_10
                             PIXEL21_30
@@ -2080,7 +2072,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL30_20
                             PIXEL31_11
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_30
                             PIXEL23_10
@@ -2098,7 +2090,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 202:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_80
                             PIXEL01_10
@@ -2116,7 +2108,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL03_80
                         PIXEL12_30
                         PIXEL13_61
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_10
                             PIXEL21_30
@@ -2138,7 +2130,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 78:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_80
                             PIXEL01_10
@@ -2156,7 +2148,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL03_82
                         PIXEL12_32
                         PIXEL13_82
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_10
                             PIXEL21_30
@@ -2178,7 +2170,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 154:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_80
                             PIXEL01_10
@@ -2192,7 +2184,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL10_11
                             PIXEL11_0
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_10
                             PIXEL03_80
@@ -2220,7 +2212,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_80
                         PIXEL01_10
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_10
                             PIXEL03_80
@@ -2238,7 +2230,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11_30
                         PIXEL20_82
                         PIXEL21_32
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_30
                             PIXEL23_10
@@ -2266,7 +2258,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11_32
                         PIXEL12_30
                         PIXEL13_10
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_10
                             PIXEL21_30
@@ -2280,7 +2272,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL30_20
                             PIXEL31_11
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_30
                             PIXEL23_10
@@ -2298,7 +2290,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 90:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_80
                             PIXEL01_10
@@ -2312,7 +2304,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL10_11
                             PIXEL11_0
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_10
                             PIXEL03_80
@@ -2326,7 +2318,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL12_0
                             PIXEL13_12
                         }
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_10
                             PIXEL21_30
@@ -2340,7 +2332,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL30_20
                             PIXEL31_11
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_30
                             PIXEL23_10
@@ -2359,7 +2351,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 55:
                 case 23:
                     {
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL00_81
                             PIXEL01_31
@@ -2394,7 +2386,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_80
                         PIXEL01_10
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -2428,7 +2420,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL00_20
                         PIXEL01_60
                         PIXEL02_81
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL03_81
                             PIXEL13_31
@@ -2468,7 +2460,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL13_10
                         PIXEL20_82
                         PIXEL21_32
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_0
                             PIXEL23_0
@@ -2499,7 +2491,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11_30
                         PIXEL12_70
                         PIXEL13_60
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_0
                             PIXEL21_0
@@ -2524,7 +2516,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 109:
                 case 105:
                     {
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL00_82
                             PIXEL10_32
@@ -2557,7 +2549,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 171:
                 case 43:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -2590,7 +2582,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 143:
                 case 15:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -2630,7 +2622,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11_30
                         PIXEL12_31
                         PIXEL13_31
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -2651,7 +2643,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 203:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -2682,7 +2674,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_80
                         PIXEL01_10
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -2720,7 +2712,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL20_61
                         PIXEL21_30
                         PIXEL22_0
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -2740,7 +2732,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_80
                         PIXEL01_10
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -2778,7 +2770,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL20_10
                         PIXEL21_30
                         PIXEL22_0
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -2804,7 +2796,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11_30
                         PIXEL12_32
                         PIXEL13_82
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -2825,7 +2817,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 155:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -3022,7 +3014,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11_30
                         PIXEL12_31
                         PIXEL13_31
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_10
                             PIXEL21_30
@@ -3037,7 +3029,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL31_11
                         }
                         PIXEL22_0
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -3053,7 +3045,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 158:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_80
                             PIXEL01_10
@@ -3067,7 +3059,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL10_11
                             PIXEL11_0
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -3092,7 +3084,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 234:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_80
                             PIXEL01_10
@@ -3110,7 +3102,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL03_80
                         PIXEL12_30
                         PIXEL13_61
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -3133,7 +3125,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_80
                         PIXEL01_10
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_10
                             PIXEL03_80
@@ -3152,7 +3144,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL20_82
                         PIXEL21_32
                         PIXEL22_0
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -3170,7 +3162,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 59:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -3182,7 +3174,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL01_50
                             PIXEL10_50
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_10
                             PIXEL03_80
@@ -3217,7 +3209,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11_32
                         PIXEL12_30
                         PIXEL13_10
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -3230,7 +3222,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL31_50
                         }
                         PIXEL21_0
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_30
                             PIXEL23_10
@@ -3250,7 +3242,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_81
                         PIXEL01_31
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -3267,7 +3259,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL12_0
                         PIXEL20_61
                         PIXEL21_30
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_30
                             PIXEL23_10
@@ -3287,7 +3279,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 79:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -3304,7 +3296,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11_0
                         PIXEL12_32
                         PIXEL13_82
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_10
                             PIXEL21_30
@@ -3326,7 +3318,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 122:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_80
                             PIXEL01_10
@@ -3340,7 +3332,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL10_11
                             PIXEL11_0
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_10
                             PIXEL03_80
@@ -3354,7 +3346,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL12_0
                             PIXEL13_12
                         }
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -3367,7 +3359,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL31_50
                         }
                         PIXEL21_0
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_30
                             PIXEL23_10
@@ -3385,7 +3377,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 94:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_80
                             PIXEL01_10
@@ -3399,7 +3391,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL10_11
                             PIXEL11_0
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -3412,7 +3404,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL13_50
                         }
                         PIXEL12_0
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_10
                             PIXEL21_30
@@ -3426,7 +3418,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL30_20
                             PIXEL31_11
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_30
                             PIXEL23_10
@@ -3444,7 +3436,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 218:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_80
                             PIXEL01_10
@@ -3458,7 +3450,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL10_11
                             PIXEL11_0
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_10
                             PIXEL03_80
@@ -3472,7 +3464,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL12_0
                             PIXEL13_12
                         }
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_10
                             PIXEL21_30
@@ -3487,7 +3479,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL31_11
                         }
                         PIXEL22_0
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -3503,7 +3495,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 91:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -3515,7 +3507,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL01_50
                             PIXEL10_50
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_10
                             PIXEL03_80
@@ -3530,7 +3522,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL13_12
                         }
                         PIXEL11_0
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_10
                             PIXEL21_30
@@ -3544,7 +3536,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL30_20
                             PIXEL31_11
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_30
                             PIXEL23_10
@@ -3642,7 +3634,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 186:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_80
                             PIXEL01_10
@@ -3656,7 +3648,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL10_11
                             PIXEL11_0
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_10
                             PIXEL03_80
@@ -3684,7 +3676,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_81
                         PIXEL01_31
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_10
                             PIXEL03_80
@@ -3702,7 +3694,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11_31
                         PIXEL20_82
                         PIXEL21_32
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_30
                             PIXEL23_10
@@ -3730,7 +3722,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11_32
                         PIXEL12_31
                         PIXEL13_31
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_10
                             PIXEL21_30
@@ -3744,7 +3736,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL30_20
                             PIXEL31_11
                         }
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_30
                             PIXEL23_10
@@ -3762,7 +3754,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 206:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_80
                             PIXEL01_10
@@ -3780,7 +3772,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL03_82
                         PIXEL12_32
                         PIXEL13_82
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_10
                             PIXEL21_30
@@ -3811,7 +3803,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11_32
                         PIXEL12_70
                         PIXEL13_60
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_10
                             PIXEL21_30
@@ -3834,7 +3826,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 174:
                 case 46:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_80
                             PIXEL01_10
@@ -3867,7 +3859,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_81
                         PIXEL01_31
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_10
                             PIXEL03_80
@@ -3906,7 +3898,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL13_31
                         PIXEL20_82
                         PIXEL21_32
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_30
                             PIXEL23_10
@@ -3968,7 +3960,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_80
                         PIXEL01_10
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -3983,7 +3975,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_10
                         PIXEL11_30
                         PIXEL12_0
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -4004,7 +3996,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 219:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -4024,7 +4016,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL20_10
                         PIXEL21_30
                         PIXEL22_0
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -4042,7 +4034,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 125:
                     {
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL00_82
                             PIXEL10_32
@@ -4077,7 +4069,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL00_82
                         PIXEL01_82
                         PIXEL02_81
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL03_81
                             PIXEL13_31
@@ -4106,7 +4098,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 207:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -4146,7 +4138,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11_30
                         PIXEL12_32
                         PIXEL13_82
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_0
                             PIXEL21_0
@@ -4172,7 +4164,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_80
                         PIXEL01_10
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -4202,7 +4194,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 187:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -4244,7 +4236,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL13_10
                         PIXEL20_82
                         PIXEL21_32
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL22_0
                             PIXEL23_0
@@ -4266,7 +4258,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 119:
                     {
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL00_81
                             PIXEL01_31
@@ -4311,7 +4303,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL21_0
                         PIXEL22_31
                         PIXEL23_81
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL30_0
                         }
@@ -4327,7 +4319,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                 case 175:
                 case 47:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                         }
@@ -4358,7 +4350,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL00_81
                         PIXEL01_31
                         PIXEL02_0
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL03_0
                         }
@@ -4398,7 +4390,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL30_82
                         PIXEL31_32
                         PIXEL32_0
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL33_0
                         }
@@ -4418,7 +4410,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11_30
                         PIXEL12_30
                         PIXEL13_10
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -4432,7 +4424,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         }
                         PIXEL21_0
                         PIXEL22_0
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -4448,7 +4440,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 123:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -4465,7 +4457,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11_0
                         PIXEL12_30
                         PIXEL13_10
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -4486,7 +4478,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 95:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -4498,7 +4490,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL01_50
                             PIXEL10_50
                         }
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -4526,7 +4518,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_80
                         PIXEL01_10
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -4544,7 +4536,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL20_10
                         PIXEL21_30
                         PIXEL22_0
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -4570,7 +4562,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11_30
                         PIXEL12_31
                         PIXEL13_31
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -4586,7 +4578,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL22_0
                         PIXEL23_0
                         PIXEL32_0
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL33_0
                         }
@@ -4609,7 +4601,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL20_0
                         PIXEL21_0
                         PIXEL22_0
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -4621,7 +4613,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL32_50
                             PIXEL33_50
                         }
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL30_0
                         }
@@ -4634,7 +4626,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 235:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -4655,7 +4647,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL21_0
                         PIXEL22_31
                         PIXEL23_81
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL30_0
                         }
@@ -4670,7 +4662,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 111:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                         }
@@ -4685,7 +4677,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL11_0
                         PIXEL12_32
                         PIXEL13_82
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -4706,7 +4698,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 63:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                         }
@@ -4715,7 +4707,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_20
                         }
                         PIXEL01_0
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -4742,7 +4734,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 159:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -4755,7 +4747,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL10_50
                         }
                         PIXEL02_0
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL03_0
                         }
@@ -4781,7 +4773,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL00_81
                         PIXEL01_31
                         PIXEL02_0
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL03_0
                         }
@@ -4796,7 +4788,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL20_61
                         PIXEL21_30
                         PIXEL22_0
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -4816,7 +4808,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_80
                         PIXEL01_10
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -4838,7 +4830,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL30_82
                         PIXEL31_32
                         PIXEL32_0
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL33_0
                         }
@@ -4852,7 +4844,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     {
                         PIXEL00_80
                         PIXEL01_10
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -4867,7 +4859,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_10
                         PIXEL11_30
                         PIXEL12_0
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -4883,7 +4875,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL22_0
                         PIXEL23_0
                         PIXEL32_0
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL33_0
                         }
@@ -4907,7 +4899,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL21_0
                         PIXEL22_0
                         PIXEL23_0
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL30_0
                         }
@@ -4917,7 +4909,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         }
                         PIXEL31_0
                         PIXEL32_0
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL33_0
                         }
@@ -4929,7 +4921,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 251:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -4949,7 +4941,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL20_0
                         PIXEL21_0
                         PIXEL22_0
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -4961,7 +4953,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL32_50
                             PIXEL33_50
                         }
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL30_0
                         }
@@ -4974,7 +4966,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 239:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                         }
@@ -4993,7 +4985,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL21_0
                         PIXEL22_31
                         PIXEL23_81
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL30_0
                         }
@@ -5008,7 +5000,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 127:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                         }
@@ -5017,7 +5009,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL00_20
                         }
                         PIXEL01_0
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL02_0
                             PIXEL03_0
@@ -5032,7 +5024,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL10_0
                         PIXEL11_0
                         PIXEL12_0
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL20_0
                             PIXEL30_0
@@ -5053,7 +5045,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 191:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                         }
@@ -5063,7 +5055,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         }
                         PIXEL01_0
                         PIXEL02_0
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL03_0
                         }
@@ -5087,7 +5079,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 223:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                             PIXEL01_0
@@ -5100,7 +5092,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                             PIXEL10_50
                         }
                         PIXEL02_0
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL03_0
                         }
@@ -5114,7 +5106,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL20_10
                         PIXEL21_30
                         PIXEL22_0
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL23_0
                             PIXEL32_0
@@ -5135,7 +5127,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL00_81
                         PIXEL01_31
                         PIXEL02_0
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL03_0
                         }
@@ -5154,7 +5146,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL30_82
                         PIXEL31_32
                         PIXEL32_0
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL33_0
                         }
@@ -5166,7 +5158,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                     }
                 case 255:
                     {
-                        if (Diff(w[4], w[2]))
+                        if (yuv_diff(yw[4], yw[2]))
                         {
                             PIXEL00_0
                         }
@@ -5176,7 +5168,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         }
                         PIXEL01_0
                         PIXEL02_0
-                        if (Diff(w[2], w[6]))
+                        if (yuv_diff(yw[2], yw[6]))
                         {
                             PIXEL03_0
                         }
@@ -5192,7 +5184,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         PIXEL21_0
                         PIXEL22_0
                         PIXEL23_0
-                        if (Diff(w[8], w[4]))
+                        if (yuv_diff(yw[8], yw[4]))
                         {
                             PIXEL30_0
                         }
@@ -5202,7 +5194,7 @@ HQX_API void HQX_CALLCONV hq4x_32_rb( uint32_t * sp, uint32_t srb, uint32_t * dp
                         }
                         PIXEL31_0
                         PIXEL32_0
-                        if (Diff(w[6], w[8]))
+                        if (yuv_diff(yw[6], yw[8]))
                         {
                             PIXEL33_0
                         }
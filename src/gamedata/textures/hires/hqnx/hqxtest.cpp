@@ -0,0 +1,163 @@
+/*
+ * hqxtest.cpp
+ * Bit-exactness check for the hqNx scalers.
+ *
+ * Scales a fixed set of generated images with hq2x/3x/4x_32_rb and compares
+ * a checksum of each result against the values in hqxtest_ref.h, which were
+ * taken from the original per-pixel implementation. Any change to the
+ * scalers must leave these unchanged, otherwise the output (and with it
+ * every texture in the upscaling disk cache) is no longer the same.
+ *
+ * Not part of the game. Build the 'hqxtest' target and run it without
+ * arguments; it returns non-zero on a mismatch. After an intended change
+ * of the output, regenerate the table with 'hqxtest -print > hqxtest_ref.h'
+ * and bump the upscaling cache version in hqresize.cpp.
+ *
+ * This program is free software; you can redistribute it and/or
+ * modify it under the terms of the GNU Lesser General Public
+ * License as published by the Free Software Foundation; either
+ * version 2.1 of the License, or (at your option) any later version.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#include "hqx.h"
+
+typedef void (HQX_CALLCONV *HQXFunc)(uint32_t *src, uint32_t src_rowBytes, uint32_t *dest, uint32_t dest_rowBytes, int width, int height);
+
+static const HQXFunc Scalers[] = { hq2x_32_rb, hq3x_32_rb, hq4x_32_rb };
+
+static const int Sizes[][2] = { { 1, 1 }, { 1, 5 }, { 5, 1 }, { 2, 2 }, { 3, 7 }, { 7, 3 }, { 13, 9 }, { 17, 33 }, { 64, 64 } };
+
+enum
+{
+	PAT_Noise,		// random colours, nearly every pixel differs from its neighbours
+	PAT_Palette,	// few colours with random alpha, large flat areas and hard edges
+	PAT_Gradient,	// smooth ramps with small noise around the difference thresholds
+	PAT_Bright,		// bright colours next to dark ones
+	NUM_PATTERNS
+};
+
+static const int NUM_SIZES = sizeof(Sizes) / sizeof(Sizes[0]);
+static const int NUM_SCALERS = sizeof(Scalers) / sizeof(Scalers[0]);
+
+// FNV-1a checksums of the output, indexed by [pattern][size][scaler].
+static const uint64_t Reference[NUM_PATTERNS][NUM_SIZES][NUM_SCALERS] =
+{
+#include "hqxtest_ref.h"
+};
+
+// The generator must give the same numbers everywhere, so rand() can't be used.
+static uint32_t Seed;
+
+static uint32_t Random()
+{
+	Seed ^= Seed << 13;
+	Seed ^= Seed >> 17;
+	Seed ^= Seed << 5;
+	return Seed;
+}
+
+static uint32_t MakePixel(int pattern, int x, int y, int width)
+{
+	uint32_t c;
+	switch (pattern)
+	{
+	default:
+	case PAT_Noise:
+		c = Random();
+		break;
+
+	case PAT_Palette:
+		c = (Random() % 4) * 0x00402010u | ((Random() & 1) ? 0xff000000u : 0);
+		break;
+
+	case PAT_Gradient:
+	{
+		uint32_t b = x * 255 / (width > 1 ? width - 1 : 1);
+		c = 0xff000000u | (b << 16) | (((b + Random() % 9) & 0xff) << 8) | (b ^ (Random() % 3));
+		break;
+	}
+
+	case PAT_Bright:
+		c = (Random() & 1) ? 0xfffefdfcu - (Random() % 3) * 0x00010101u : 0xff000000u | ((Random() % 5) << 16);
+		break;
+	}
+	// Full white is avoided because hqxInit leaves the last entry of the YUV table uninitialized.
+	if ((c & 0xffffff) == 0xffffff) c ^= 1;
+	return c;
+}
+
+static uint64_t Checksum(const std::vector<uint32_t> &buffer)
+{
+	uint64_t hash = 14695981039346656037ull;
+	for (auto pixel : buffer)
+	{
+		for (int i = 0; i < 4; i++)
+		{
+			hash = (hash ^ ((pixel >> (i * 8)) & 0xff)) * 1099511628211ull;
+		}
+	}
+	return hash;
+}
+
+int main(int argc, char **argv)
+{
+	bool print = argc > 1 && !strcmp(argv[1], "-print");
+	int failures = 0;
+
+	hqxInit();
+	Seed = 0x1234567;
+
+	if (print) printf("// Reference checksums for hqxtest.cpp, generated with 'hqxtest -print'.\n");
+
+	for (int pattern = 0; pattern < NUM_PATTERNS; pattern++)
+	{
+		if (print) printf("{\n");
+		for (int size = 0; size < NUM_SIZES; size++)
+		{
+			int width = Sizes[size][0], height = Sizes[size][1];
+
+			// Both images have padding at the end of each row to check that the pitch is honored
+			// and that nothing outside the image gets written to.
+			int srcpitch = width + 3;
+			std::vector<uint32_t> src(srcpitch * height, 0xdeadbeef);
+			for (int y = 0; y < height; y++)
+			{
+				for (int x = 0; x < width; x++)
+				{
+					src[y * srcpitch + x] = MakePixel(pattern, x, y, width);
+				}
+			}
+
+			if (print) printf("\t{ ");
+			for (int scaler = 0; scaler < NUM_SCALERS; scaler++)
+			{
+				int mult = scaler + 2;
+				int dstpitch = width * mult + 5;
+				std::vector<uint32_t> dst(dstpitch * height * mult, 0xcafebabe);
+				Scalers[scaler](src.data(), srcpitch * 4, dst.data(), dstpitch * 4, width, height);
+
+				uint64_t sum = Checksum(dst);
+				if (print)
+				{
+					printf("0x%016llxull%s", (unsigned long long)sum, scaler < NUM_SCALERS - 1 ? ", " : " ");
+				}
+				else if (sum != Reference[pattern][size][scaler])
+				{
+					printf("hq%dx mismatch: pattern %d, %dx%d\n", mult, pattern, width, height);
+					failures++;
+				}
+			}
+			if (print) printf("},\n");
+		}
+		if (print) printf("},\n");
+	}
+
+	if (!print)
+	{
+		printf(failures == 0 ? "All hqNx results match.\n" : "%d hqNx results differ.\n", failures);
+	}
+	return failures != 0;
+}
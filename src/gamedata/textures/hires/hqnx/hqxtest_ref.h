@@ -0,0 +1,45 @@
+// Reference checksums for hqxtest.cpp, generated with 'hqxtest -print'.
+{
+	{ 0x40508edc3a55cdfdull, 0x550f01a1a188dc93ull, 0xe53a1368aa1937c5ull },
+	{ 0x954b3f8ab5695365ull, 0x8e8f61c97931c9f9ull, 0xc67ff935b24e7c25ull },
+	{ 0x1a70d6a96a612a21ull, 0x30a14f23318f1677ull, 0x9c5b635096fd3285ull },
+	{ 0x48987e8e85b52e0dull, 0x0f964bf3dec1c3abull, 0x8a3e4c2341016ac5ull },
+	{ 0x5cfaf235b61ed57dull, 0x682f620bd2d73147ull, 0x9c75291e6db87f85ull },
+	{ 0xd552e22496ca5d2dull, 0x6ccb82907e2a9e4dull, 0x71ddccb545378305ull },
+	{ 0xa2a66671103220cdull, 0x2eeedb29f475e319ull, 0x09ea1c503575d7c5ull },
+	{ 0x8d68ab0e62619f2full, 0x2eb82688456ac028ull, 0x7f6cc6f2311df427ull },
+	{ 0xc11990f1d4b27fc2ull, 0xa27f2a5118e52fabull, 0xfd1e60314ffbb315ull },
+},
+{
+	{ 0x3c14b5482f2774a5ull, 0xfa4a6f29806edd08ull, 0xed5dc4ef5273f925ull },
+	{ 0xee49fc4c12465ea5ull, 0x6639eade7e309a68ull, 0x71545b953adcb925ull },
+	{ 0x08e104f5afb6af25ull, 0xfe1d48a2b1e8e1d5ull, 0xaafb8d8d8fe37025ull },
+	{ 0x246b2c849c3962daull, 0x54d696dbe1554dbdull, 0x5a6e0323029c1110ull },
+	{ 0x0a4d8b468cbee4f4ull, 0x5d8ed8eaa993f791ull, 0x348777ffa6d5cdc0ull },
+	{ 0x85d70cffadd82164ull, 0x94a6125aef1377d0ull, 0xc911fe0f260775a8ull },
+	{ 0x833d35ab5e09c7f8ull, 0x830f0e68cb5a8a87ull, 0x54f84fc1053cd815ull },
+	{ 0x6089d0f4432948a3ull, 0xe92c6710c488dcc5ull, 0x7113a687a95ca045ull },
+	{ 0x49126e0705c36334ull, 0x22ad325d0f19d651ull, 0x1058366085583958ull },
+},
+{
+	{ 0x50d3a6ef2175383dull, 0x0088452ac7447f0full, 0xd3b0faed92dd8345ull },
+	{ 0x2c8904397f614e5dull, 0x54d456e79a9c798eull, 0xd15cd4f8bc3dbde5ull },
+	{ 0x4bdba9de78c4e1a5ull, 0x3d1437540968d1a5ull, 0x10111189a9f38325ull },
+	{ 0x75a3f4b9acaee01dull, 0xd8eda2ebcef78be7ull, 0x49e9d0aadd4d6ee5ull },
+	{ 0x5f1ee237290779ddull, 0x692b8887cc63e3c4ull, 0x537607c8b1d8fde5ull },
+	{ 0xa6518453448dc9eeull, 0xb38e635c91abcfd3ull, 0x3f96bb89337b3cffull },
+	{ 0xa00b2c32536d50feull, 0x049c66cb5d10d793ull, 0xa7b2fddbc07d5234ull },
+	{ 0xe8b0d577f4b37d1aull, 0x26e81c920f16ad2cull, 0x82ec44d362f37471ull },
+	{ 0x9141e2f9e7969d12ull, 0x9bfe6779039df1a4ull, 0x8f8c062c657ab181ull },
+},
+{
+	{ 0x5b6e90e3d1a54dedull, 0xe7728ff27c79ebbfull, 0x826f7672d8cd75c5ull },
+	{ 0xcf86d56ad9b62a05ull, 0xaee7b9e9787d689aull, 0x928f20a1b8855ee5ull },
+	{ 0x695642001152decdull, 0x0376ee2f3c2d962cull, 0x823eb561420aeb25ull },
+	{ 0x07f9a050e295057dull, 0x88c268a60cd4ba18ull, 0xf10301750e4b3ec5ull },
+	{ 0x09a18038612e12abull, 0x1cfe0e89206a7019ull, 0x18a63602486e3f22ull },
+	{ 0x398057d772c2aa0aull, 0x7a73165da8f6ab5cull, 0x10e112dc599dbcbdull },
+	{ 0x41334a157292011eull, 0x659899c15faaa7cbull, 0xd27f62de30c827e1ull },
+	{ 0x11eaa04d59c68c74ull, 0x2990e40234e32cb8ull, 0x4f8006531b99c3f6ull },
+	{ 0x80d6ebf347406f1eull, 0x36ef05fb2cf60b5dull, 0x1294fca9377bf1ccull },
+},
@@ -44,6 +44,13 @@
 #include "xbr/xbrz_old.h"
 #include "parallel_for.h"
 #include "hwrenderer/textures/hw_material.h"
+#include "m_misc.h"
+#include "cmdlib.h"
+#include "md5.h"
+#include "files.h"
+#include <zlib.h>
+#include <atomic>
+#include <memory>
 
 EXTERN_CVAR(Int, gl_texture_hqresizemult)
 CUSTOM_CVAR(Int, gl_texture_hqresizemode, 0, CVAR_ARCHIVE | CVAR_GLOBALCONFIG | CVAR_NOINITCALL)
@@ -80,6 +87,7 @@ CVAR (Flag, gl_texture_hqresize_sprites, gl_texture_hqresize_targets, 2);
 CVAR (Flag, gl_texture_hqresize_fonts, gl_texture_hqresize_targets, 4);
 
 CVAR(Bool, gl_texture_hqresize_multithread, true, CVAR_ARCHIVE | CVAR_GLOBALCONFIG);
+CVAR(Bool, gl_texture_hqresize_cache, true, CVAR_ARCHIVE | CVAR_GLOBALCONFIG);
 
 CUSTOM_CVAR(Int, gl_texture_hqresize_mt_width, 16, CVAR_ARCHIVE | CVAR_GLOBALCONFIG)
 {
@@ -258,13 +266,9 @@ static unsigned char *hqNxAsmHelper( void (*hqNxFunction) ( int*, unsigned char*
 	outWidth = N * inWidth;
 	outHeight = N *inHeight;
 
-	static int initdone = false;
-
-	if (!initdone)
-	{
-		HQnX_asm::InitLUTs();
-		initdone = true;
-	}
+	// This may be called from several threads during precaching so let the compiler guard the initialization.
+	static bool initdone = (HQnX_asm::InitLUTs(), true);
+	(void)initdone;
 
 	HQnX_asm::CImage cImageIn;
 	cImageIn.SetImage(inputBuffer, inWidth, inHeight, 32);
@@ -285,13 +289,9 @@ static unsigned char *hqNxHelper( void (HQX_CALLCONV *hqNxFunction) ( unsigned*,
 							  int &outWidth,
 							  int &outHeight )
 {
-	static int initdone = false;
+	static bool initdone = (hqxInit(), true);
+	(void)initdone;
 
-	if (!initdone)
-	{
-		hqxInit();
-		initdone = true;
-	}
 	outWidth = N * inWidth;
 	outHeight = N *inHeight;
 
@@ -346,6 +346,102 @@ static void xbrzOldScale(size_t factor, const uint32_t* src, uint32_t* trg, int
 }
 
 
+//===========================================================================
+//
+// Disk cache for upscaled textures
+//
+// Each entry is a zlib compressed file named after the MD5 of the source
+// pixels, the scaler settings and the scaler's version, so identical images
+// share one entry and a changed image can never pick up stale data.
+//
+// There is no size limit. Entries are never removed, not even the ones an
+// older scaler version left behind, so the hqcache directory keeps growing
+// with every new texture set and setting that gets used. Deleting it is
+// always safe, it just gets filled again.
+//
+// All of this may run on the precaching worker threads.
+//
+//===========================================================================
+
+static const char HQCacheMagic[4] = { 'H', 'Q', 'C', '1' };
+
+// Indexed by gl_texture_hqresizemode. The entry of a scaler must be bumped
+// whenever a change to it alters its output, so that it doesn't get
+// mixed with what the old version cached.
+static const int32_t HQCacheScalerVersion[] = { 0, 1, 1, 1, 1, 1, 1 };
+
+static FString GetHQCacheName(const uint8_t *buffer, int width, int height, int type, int mult)
+{
+	static const FString dir = []()
+	{
+		FString path = M_GetCachePath(true);
+		path << "/hqcache/";
+		CreatePath(path);
+		return path;
+	}();
+
+	uint8_t digest[16];
+	int32_t params[5] = { width, height, type, mult, HQCacheScalerVersion[type] };
+	MD5Context md5;
+	md5.Update((const uint8_t *)params, sizeof(params));
+	md5.Update(buffer, width * height * 4);
+	md5.Final(digest);
+
+	char hexdigest[33];
+	for (int i = 0; i < 16; i++)
+	{
+		int v = digest[i] >> 4;
+		hexdigest[i * 2] = v < 10 ? ('0' + v) : ('a' + v - 10);
+		v = digest[i] & 15;
+		hexdigest[i * 2 + 1] = v < 10 ? ('0' + v) : ('a' + v - 10);
+	}
+	hexdigest[32] = 0;
+	return FStringf("%s%s.hqc", dir.GetChars(), hexdigest);
+}
+
+static unsigned char *LoadHQCache(const FString &name, int width, int height)
+{
+	FileReader fr;
+	if (!fr.OpenFile(name)) return nullptr;
+
+	char magic[4];
+	uint32_t header[3];	// width, height, compressed size
+	uLongf size = width * height * 4;
+	if (fr.Read(magic, 4) != 4 || memcmp(magic, HQCacheMagic, 4) != 0) return nullptr;
+	if (fr.Read(header, sizeof(header)) != sizeof(header)) return nullptr;
+	if (header[0] != (uint32_t)width || header[1] != (uint32_t)height || header[2] > compressBound(size)) return nullptr;
+
+	TArray<uint8_t> compressed(header[2], true);
+	if (fr.Read(compressed.Data(), header[2]) != header[2]) return nullptr;
+
+	unsigned char *buffer = new unsigned char[size];
+	uLongf outsize = size;
+	if (uncompress(buffer, &outsize, compressed.Data(), header[2]) != Z_OK || outsize != size)
+	{
+		delete[] buffer;
+		return nullptr;
+	}
+	return buffer;
+}
+
+static void SaveHQCache(const FString &name, const unsigned char *buffer, int width, int height)
+{
+	uLongf size = compressBound(width * height * 4);
+	TArray<uint8_t> compressed(size, true);
+	if (compress2(compressed.Data(), &size, buffer, width * height * 4, Z_BEST_SPEED) != Z_OK) return;
+
+	// Write to a unique temporary file first so that a concurrent reader or writer never sees a partial entry.
+	static std::atomic<int> tempcount;
+	FString tempname = FStringf("%s.%d.tmp", name.GetChars(), tempcount++);
+	std::unique_ptr<FileWriter> fw(FileWriter::Open(tempname));
+	if (!fw) return;
+
+	uint32_t header[3] = { (uint32_t)width, (uint32_t)height, (uint32_t)size };
+	bool ok = fw->Write(HQCacheMagic, 4) == 4 && fw->Write(header, sizeof(header)) == sizeof(header) && fw->Write(compressed.Data(), size) == size;
+	fw.reset();
+	if (!ok || rename(tempname, name) != 0) remove(tempname);
+}
+
 //===========================================================================
 // 
 // [BB] Upsamples the texture in texbuffer.mBuffer, frees texbuffer.mBuffer and returns
@@ -402,7 +498,17 @@ void FTexture::CreateUpsampledTextureBuffer(FTextureBuffer &texbuffer, bool hasA
 
 	if (!checkonly)
 	{
-		if (type == 1)
+		FString cachename = gl_texture_hqresize_cache ? GetHQCacheName(texbuffer.mBuffer, inWidth, inHeight, type, mult) : FString();
+		unsigned char *cached = cachename.IsNotEmpty() ? LoadHQCache(cachename, inWidth * mult, inHeight * mult) : nullptr;
+
+		if (cached != nullptr)
+		{
+			delete[] texbuffer.mBuffer;
+			texbuffer.mBuffer = cached;
+			texbuffer.mWidth = inWidth * mult;
+			texbuffer.mHeight = inHeight * mult;
+		}
+		else if (type == 1)
 		{
 			if (mult == 2)
 				texbuffer.mBuffer = scaleNxHelper(&scale2x, 2, texbuffer.mBuffer, inWidth, inHeight, texbuffer.mWidth, texbuffer.mHeight);
@@ -442,6 +548,11 @@ void FTexture::CreateUpsampledTextureBuffer(FTextureBuffer &texbuffer, bool hasA
 			texbuffer.mBuffer = normalNxHelper(&normalNx, mult, texbuffer.mBuffer, inWidth, inHeight, texbuffer.mWidth, texbuffer.mHeight);
 		else
 			return;
+
+		if (cached == nullptr && cachename.IsNotEmpty())
+		{
+			SaveHQCache(cachename, texbuffer.mBuffer, texbuffer.mWidth, texbuffer.mHeight);
+		}
 	}
 	else
 	{
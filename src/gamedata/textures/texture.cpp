@@ -52,9 +52,17 @@
 #include "image.h"
 #include "formats/multipatchtexture.h"
 #include "g_levellocals.h"
+#include "parallel_for.h"
+#include "i_time.h"
+#include <algorithm>
+#include <functional>
+#include <thread>
+#include <atomic>
 
 FTexture *CreateBrightmapTexture(FImageSource*);
 
+EXTERN_CVAR(Bool, gl_texture_streaming)
+
 // Make sprite offset adjustment user-configurable per renderer.
 int r_spriteadjustSW, r_spriteadjustHW;
 CUSTOM_CVAR(Int, r_spriteadjust, 2, CVAR_ARCHIVE | CVAR_GLOBALCONFIG)
@@ -686,15 +694,50 @@ FTextureBuffer FTexture::CreateTexBuffer(int translation, int flags)
 {
 	FTextureBuffer result;
 
+	if ((flags & CTF_ProcessData) && !(flags & CTF_CheckOnly) && PreparedTexBuffers.Size() > 0)
+	{
+		unsigned index = PreparedTexBuffers.FindEx([=](const FPreparedTexBuffer &entry)
+		{
+			return entry.Request.tex == this && entry.Request.translation == translation && entry.Request.flags == flags;
+		});
+		if (index < PreparedTexBuffers.Size())
+		{
+			result = std::move(PreparedTexBuffers[index].Buffer);
+			PreparedTexBuffers.Delete(index);
+			return result;
+		}
+	}
+
+	if ((flags & CTF_ProcessData) && !(flags & CTF_CheckOnly) && StreamTexBuffer(result, translation, flags))
+	{
+		return result;
+	}
+
+	int isTransparent = -1;
+	if (ComposeTexBuffer(result, translation, flags, isTransparent))
+	{
+		PostProcessTexBuffer(result, isTransparent, flags);
+	}
+	return result;
+}
+
+//===========================================================================
+// 
+//	Creates the unprocessed texture data. Returns false if the buffer
+//	came from a hires replacement and must not be processed further.
+//
+//===========================================================================
+
+bool FTexture::ComposeTexBuffer(FTextureBuffer &result, int translation, int flags, int &isTransparent)
+{
 	unsigned char * buffer = nullptr;
 	int W, H;
-	int isTransparent = -1;
 	bool checkonly = !!(flags & CTF_CheckOnly);
 
 	if (flags & CTF_CheckHires)
 	{
 		// No image means that this cannot be checked,
-		if (GetImage() && LoadHiresTexture(result, checkonly)) return result;
+		if (GetImage() && LoadHiresTexture(result, checkonly)) return false;
 	}
 	int exx = !!(flags & CTF_Expand);
 
@@ -739,6 +782,20 @@ FTextureBuffer FTexture::CreateTexBuffer(int translation, int flags)
 	result.mBuffer = buffer;
 	result.mWidth = W;
 	result.mHeight = H;
+	return true;
+}
+
+//===========================================================================
+// 
+//	Upscaling and edge processing. This only works on the buffer and
+//	the texture's own flags so it may run on a worker thread, as long
+//	as no two threads process the same texture at the same time.
+//
+//===========================================================================
+
+void FTexture::PostProcessTexBuffer(FTextureBuffer &result, int isTransparent, int flags)
+{
+	bool checkonly = !!(flags & CTF_CheckOnly);
 
 	// Only do postprocessing for image-backed textures. (i.e. not for the burn texture which can also pass through here.)
 	if (GetImage() && flags & CTF_ProcessData) 
@@ -746,8 +803,243 @@ FTextureBuffer FTexture::CreateTexBuffer(int translation, int flags)
 		CreateUpsampledTextureBuffer(result, !!isTransparent, checkonly);
 		if (!checkonly) ProcessData(result.mBuffer, result.mWidth, result.mHeight, false);
 	}
+}
 
-	return result;
+//===========================================================================
+// 
+//	Creates the texture buffers for a list of requests ahead of time.
+//	Composing the image has to be done here because the image sources
+//	share their caches and the file readers, but the postprocessing,
+//	which is by far the most expensive part with hq-resizing enabled,
+//	is spread across all cores. The requests may come in any order and
+//	may contain duplicates. The results get picked up by CreateTexBuffer.
+//
+//===========================================================================
+
+TArray<FPreparedTexBuffer> FTexture::PreparedTexBuffers;
+
+void FTexture::PrepareTexBuffers(const TArray<FTexBufferRequest> &requests)
+{
+	ReleasePreparedTexBuffers();
+
+	// The same texture can be requested more than once and not necessarily
+	// in a row (e.g. when it is used as a wall and as a sprite), so sort the
+	// requests to get all of a texture's buffers into one group and drop
+	// exact duplicates.
+	TArray<FTexBufferRequest> sorted = requests;
+	std::sort(sorted.begin(), sorted.end(), [](const FTexBufferRequest &a, const FTexBufferRequest &b)
+	{
+		if (a.tex != b.tex) return std::less<FTexture *>()(a.tex, b.tex);
+		if (a.translation != b.translation) return a.translation < b.translation;
+		return a.flags < b.flags;
+	});
+	unsigned count = 0;
+	for (unsigned i = 0; i < sorted.Size(); i++)
+	{
+		auto &req = sorted[i];
+		if (count > 0 && sorted[count - 1].tex == req.tex && sorted[count - 1].translation == req.translation && sorted[count - 1].flags == req.flags) continue;
+		sorted[count++] = req;
+	}
+	sorted.Resize(count);
+	PreparedTexBuffers.Resize(count);
+
+	TArray<int> transparent(count, true);
+	TArray<unsigned> groups;
+	for (unsigned i = 0; i < count; i++)
+	{
+		auto &entry = PreparedTexBuffers[i];
+		entry.Request = sorted[i];
+		entry.Processed = entry.Request.tex->ComposeTexBuffer(entry.Buffer, entry.Request.translation, entry.Request.flags, transparent[i]);
+		if (i == 0 || sorted[i].tex != sorted[i - 1].tex) groups.Push(i);
+	}
+	groups.Push(count);
+
+	// All translations of a texture are processed by the same thread because ProcessData alters the texture's flags.
+	parallel_for((int)groups.Size() - 1, [&](int group)
+	{
+		for (unsigned i = groups[group]; i < groups[group + 1]; i++)
+		{
+			auto &entry = PreparedTexBuffers[i];
+			if (entry.Processed) entry.Request.tex->PostProcessTexBuffer(entry.Buffer, transparent[i], entry.Request.flags);
+		}
+	});
+}
+
+void FTexture::ReleasePreparedTexBuffers()
+{
+	PreparedTexBuffers.Reset();
+}
+
+//===========================================================================
+// 
+//	Texture streaming
+//
+//	With gl_texture_streaming on, a texture whose full buffer is expensive
+//	to create, i.e. one with a hires replacement or one that gets upscaled,
+//	is first uploaded from its original image without either. The full
+//	buffer gets created in the following frames and replaces this stand-in:
+//
+//	- UpdateStreaming composes the pending buffers on the main thread, the
+//	  most recently requested ones first because those are in view, until
+//	  the time budget for the frame is used up. This includes decoding the
+//	  hires replacements, because the image sources and the file readers
+//	  cannot be used from another thread.
+//	- The upscaling runs on a background thread.
+//	- The finished buffers get reported back to the renderer, which deletes
+//	  the stand-ins. CreateTexBuffer picks up the buffers when the textures
+//	  get created again. ProcessData is left until then because it alters
+//	  the texture's flags, which the renderer reads.
+//
+//===========================================================================
+
+enum
+{
+	STREAM_TIMEBUDGET = 2,		// milliseconds per frame for composing buffers on the main thread
+};
+
+enum EStreamState
+{
+	STREAM_Pending,
+	STREAM_Processing,
+	STREAM_Ready,
+};
+
+struct FStreamedTexBuffer
+{
+	FTexBufferRequest Request;
+	FTextureBuffer Buffer;
+	int isTransparent = -1;
+	EStreamState State = STREAM_Pending;
+	bool Processed = false;		// false for hires replacements, which must not be processed further.
+};
+
+// Anything the background thread works on is in StreamBatch, which the main thread
+// leaves alone until the thread is done, except for reading the requests.
+static TArray<FStreamedTexBuffer> StreamedTexBuffers, StreamBatch;
+static std::atomic<bool> StreamBusy;
+
+static struct FStreamThread
+{
+	std::thread Thread;
+
+	~FStreamThread()
+	{
+		if (Thread.joinable()) Thread.join();
+	}
+} StreamThread;
+
+bool FTexture::StreamTexBuffer(FTextureBuffer &result, int translation, int flags)
+{
+	if (GetImage() == nullptr || bHasCanvas) return false;
+
+	auto match = [=](const FStreamedTexBuffer &entry)
+	{
+		return entry.Request.tex == this && entry.Request.translation == translation && entry.Request.flags == flags;
+	};
+	unsigned index = StreamedTexBuffers.FindEx(match);
+	if (index < StreamedTexBuffers.Size() && StreamedTexBuffers[index].State == STREAM_Ready)
+	{
+		auto &entry = StreamedTexBuffers[index];
+		result = std::move(entry.Buffer);
+		if (entry.Processed) ProcessData(result.mBuffer, result.mWidth, result.mHeight, false);
+		StreamedTexBuffers.Delete(index);
+		return true;
+	}
+	if (index >= StreamedTexBuffers.Size() && StreamBatch.FindEx(match) >= StreamBatch.Size())
+	{
+		if (!gl_texture_streaming) return false;
+
+		// Only stream what is expensive to create. ComposeTexBuffer returns false for a hires replacement.
+		FTextureBuffer check;
+		int isTransparent;
+		if (ComposeTexBuffer(check, translation, flags | CTF_CheckOnly, isTransparent))
+		{
+			int width = check.mWidth;
+			CreateUpsampledTextureBuffer(check, false, true);
+			if (check.mWidth == width) return false;
+		}
+		auto &entry = StreamedTexBuffers[StreamedTexBuffers.Reserve(1)];
+		entry.Request = { this, translation, flags };
+	}
+
+	// Still pending or in progress, so use the stand-in.
+	int isTransparent = -1;
+	ComposeTexBuffer(result, translation, flags & ~CTF_CheckHires, isTransparent);
+	ProcessData(result.mBuffer, result.mWidth, result.mHeight, false);
+	return true;
+}
+
+//===========================================================================
+// 
+//	Called once per frame. Returns the requests whose full buffer got
+//	finished so that the renderer can delete their stand-ins.
+//
+//===========================================================================
+
+void FTexture::UpdateStreaming(TArray<FTexBufferRequest> &finished)
+{
+	if (StreamBusy) return;
+	if (StreamThread.Thread.joinable()) StreamThread.Thread.join();
+	for (auto &entry : StreamBatch)
+	{
+		finished.Push(entry.Request);
+		entry.State = STREAM_Ready;
+		StreamedTexBuffers.Push(std::move(entry));
+	}
+	StreamBatch.Clear();
+
+	uint64_t start = I_msTime();
+	for (int i = StreamedTexBuffers.Size() - 1; i >= 0 && I_msTime() - start < STREAM_TIMEBUDGET; i--)
+	{
+		auto &entry = StreamedTexBuffers[i];
+		if (entry.State != STREAM_Pending) continue;
+
+		auto &req = entry.Request;
+		entry.Processed = req.tex->ComposeTexBuffer(entry.Buffer, req.translation, req.flags, entry.isTransparent);
+		entry.State = STREAM_Processing;
+		StreamBatch.Push(std::move(entry));
+		StreamedTexBuffers.Delete(i);
+	}
+	if (StreamBatch.Size() == 0) return;
+
+	// Only the upscaling is done here. It only works on the buffer and reads the texture's settings.
+	StreamBusy = true;
+	StreamThread.Thread = std::thread([]()
+	{
+		for (auto &entry : StreamBatch)
+		{
+			if (entry.Processed) entry.Request.tex->CreateUpsampledTextureBuffer(entry.Buffer, !!entry.isTransparent, false);
+		}
+		StreamBusy = false;
+	});
+}
+
+//===========================================================================
+// 
+//	Discards everything that's being streamed, or only what belongs to
+//	the given texture. Must be called before the textures get deleted or
+//	their hardware textures get flushed.
+//
+//===========================================================================
+
+void FTexture::ResetStreaming(FTexture *tex)
+{
+	if (StreamThread.Thread.joinable()) StreamThread.Thread.join();
+	if (tex == nullptr)
+	{
+		StreamBatch.Clear();
+		StreamedTexBuffers.Clear();
+		return;
+	}
+	// UpdateStreaming still collects the rest of the batch.
+	for (int i = StreamBatch.Size() - 1; i >= 0; i--)
+	{
+		if (StreamBatch[i].Request.tex == tex) StreamBatch.Delete(i);
+	}
+	for (int i = StreamedTexBuffers.Size() - 1; i >= 0; i--)
+	{
+		if (StreamedTexBuffers[i].Request.tex == tex) StreamedTexBuffers.Delete(i);
+	}
 }
 
 //===========================================================================
@@ -101,6 +101,7 @@ FTextureManager::~FTextureManager ()
 
 void FTextureManager::DeleteAll()
 {
+	FTexture::ResetStreaming();
 	FImageSource::ClearImages();
 	for (unsigned int i = 0; i < Textures.Size(); ++i)
 	{
@@ -109,8 +110,10 @@ void FTextureManager::DeleteAll()
 	Textures.Clear();
 	Translation.Clear();
 	FirstTextureForFile.Clear();
+	FreeSlots.Clear();
 	memset (HashFirst, -1, sizeof(HashFirst));
 	DefaultTexture.SetInvalid();
+	Generation++;
 
 	for (unsigned i = 0; i < mAnimations.Size(); i++)
 	{
@@ -158,6 +161,7 @@ void FTextureManager::DeleteAll()
 
 void FTextureManager::FlushAll()
 {
+	FTexture::ResetStreaming();
 	for (int i = TexMan.NumTextures() - 1; i >= 0; i--)
 	{
 		for (int j = 0; j < 2; j++)
@@ -487,6 +491,15 @@ FTextureID FTextureManager::AddTexture (FTexture *texture)
 	{
 		bucket = -1;
 		hash = -1;
+
+		if (FreeSlots.Size() > 0)
+		{
+			int slot;
+			FreeSlots.Pop(slot);
+			delete Textures[slot].Texture;
+			Textures[slot] = { texture, hash, false };
+			return (texture->id = FTextureID(slot));
+		}
 	}
 
 	TextureHash hasher = { texture, hash };
@@ -542,6 +555,33 @@ void FTextureManager::ReplaceTexture (FTextureID picnum, FTexture *newtexture, b
 	newtexture->id = oldtexture->id;
 	oldtexture->Name = "";
 	AddTexture(oldtexture);
+	Generation++;
+}
+
+//==========================================================================
+//
+// FTextureManager :: RemoveTexture
+//
+// Deletes an unnamed texture that nothing refers to by its ID anymore.
+// The slot gets a null placeholder until the next unnamed texture gets
+// added, so that textures which get thrown away and created again, like
+// the font atlases, don't pile up.
+//
+//==========================================================================
+
+void FTextureManager::RemoveTexture (FTexture *texture)
+{
+	int index = texture->id.GetIndex();
+	if (unsigned(index) >= Textures.Size() || Textures[index].Texture != texture || texture->Name.IsNotEmpty())
+		return;
+
+	FTexture::ResetStreaming(texture);
+	auto nulltex = new FImageTexture(nullptr, "");
+	nulltex->SetUseType(ETextureType::Null);
+	nulltex->id = texture->id;
+	Textures[index].Texture = nulltex;
+	FreeSlots.Push(index);
+	delete texture;
 }
 
 //==========================================================================
@@ -126,6 +126,7 @@ class FTerrainTypeArray;
 class IHardwareTexture;
 class FMaterial;
 class FMultipatchTextureBuilder;
+class FTexture;
 
 extern int r_spriteadjustSW, r_spriteadjustHW;
 
@@ -276,6 +277,21 @@ struct FTextureBuffer
 
 };
 
+// A texture buffer that gets created ahead of its upload. See FTexture::PrepareTexBuffers.
+struct FTexBufferRequest
+{
+	FTexture *tex;
+	int translation;	// as passed to CreateTexBuffer
+	int flags;
+};
+
+struct FPreparedTexBuffer
+{
+	FTexBufferRequest Request;
+	FTextureBuffer Buffer;
+	bool Processed;
+};
+
 // Base texture class
 class FTexture
 {
@@ -499,7 +515,18 @@ public:
 	FTextureBuffer CreateTexBuffer(int translation, int flags = 0);
 	bool GetTranslucency();
 
+	static void PrepareTexBuffers(const TArray<FTexBufferRequest> &requests);
+	static void ReleasePreparedTexBuffers();
+	static void UpdateStreaming(TArray<FTexBufferRequest> &finished);
+	static void ResetStreaming(FTexture *tex = nullptr);
+
 private:
+	bool ComposeTexBuffer(FTextureBuffer &result, int translation, int flags, int &isTransparent);
+	void PostProcessTexBuffer(FTextureBuffer &result, int isTransparent, int flags);
+	bool StreamTexBuffer(FTextureBuffer &result, int translation, int flags);
+
+	static TArray<FPreparedTexBuffer> PreparedTexBuffers;
+
 	int CheckDDPK3();
 	int CheckExternalFile(bool & hascolorkey);
 	bool LoadHiresTexture(FTextureBuffer &texbuffer, bool checkonly);
@@ -607,6 +634,7 @@ public:
 	FTextureID CreateTexture (int lumpnum, ETextureType usetype=ETextureType::Any);	// Also calls AddTexture
 	FTextureID AddTexture (FTexture *texture);
 	FTextureID GetDefaultTexture() const { return DefaultTexture; }
+	int GetGeneration() const { return Generation; }	// changes whenever textures get deleted or replaced
 
 	void LoadTextureX(int wadnum, FMultipatchTextureBuilder &build);
 	void AddTexturesForWad(int wadnum, FMultipatchTextureBuilder &build);
@@ -615,6 +643,7 @@ public:
 	void SpriteAdjustChanged();
 
 	void ReplaceTexture (FTextureID picnum, FTexture *newtexture, bool free);
+	void RemoveTexture (FTexture *texture);
 
 	int NumTextures () const { return (int)Textures.Size(); }
 
@@ -674,8 +703,10 @@ private:
 	TArray<TextureHash> Textures;
 	TMap<uint64_t, int> LocalizedTextures;
 	TArray<int> Translation;
+	TArray<int> FreeSlots;		// Left behind by RemoveTexture
 	int HashFirst[HASH_SIZE];
 	FTextureID DefaultTexture;
+	int Generation = 0;
 	TArray<int> FirstTextureForFile;
 	TArray<TArray<uint8_t> > BuildTileData;
 
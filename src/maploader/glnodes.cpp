@@ -910,6 +910,7 @@ bool MapLoader::CheckNodes(MapData * map, bool rebuilt, int buildtime)
 			};
 			leveldata.FindMapBounds ();
 			FNodeBuilder builder (leveldata, polyspots, anchors, true);
+			builder.PrintMessages ();
 			
 			builder.Extract (*Level);
 			endTime = I_msTime ();
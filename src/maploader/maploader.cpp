@@ -3112,6 +3112,7 @@ void MapLoader::LoadLevel(MapData *map, const char *lumpname, int position)
 	uint64_t startTime = 0, endTime = 0;
 
 	bool BuildGLNodes;
+	bool rejectLoaded = false;
 
 	// The node builder needs these indices.
 	for (unsigned int i = 0; i < Level->sides.Size(); ++i)
@@ -3140,7 +3141,13 @@ void MapLoader::LoadLevel(MapData *map, const char *lumpname, int position)
 		};
 		leveldata.FindMapBounds();
 
-		FNodeBuilder builder(leveldata, polyspots, anchors, BuildGLNodes);
+		FNodeBuildTask buildtask(leveldata, polyspots, anchors, BuildGLNodes);
+
+		// The REJECT does not depend on the nodes so it can be read while they are being built.
+		LoadReject(map, false);
+		rejectLoaded = true;
+
+		FNodeBuilder &builder = buildtask.Wait();
 		builder.Extract(*Level);
 		endTime = I_msTime();
 		DPrintf(DMSG_NOTIFY, "BSP generation took %.3f sec (%d segs)\n", (endTime - startTime) * 0.001, Level->segs.Size());
@@ -3181,7 +3188,7 @@ void MapLoader::LoadLevel(MapData *map, const char *lumpname, int position)
 
 	LoadBlockMap(map);
 
-	LoadReject(map, false);
+	if (!rejectLoaded) LoadReject(map, false);
 	GroupLines(false);
 	FloodZones();
 	SetRenderSector();
@@ -3240,7 +3247,7 @@ void MapLoader::LoadLevel(MapData *map, const char *lumpname, int position)
 
 	InitRenderInfo();				// create hardware independent renderer resources for the level. This must be done BEFORE the PolyObj Spawn!!!
 	Level->ClearDynamic3DFloorData();	// CreateVBO must be run on the plain 3D floor data.
-	screen->mVertexData->CreateVBO(Level->sectors);
+	screen->mVertexData->CreateVBO(Level->sectors, Level->segs);
 
 	for (auto &sec : Level->sectors)
 	{
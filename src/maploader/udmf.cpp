@@ -51,6 +51,10 @@
 #include "vm.h"
 #include "xlat/xlat.h"
 #include "maploader.h"
+#include "v_text.h"
+#include "i_time.h"
+#include "parallel_for.h"
+#include "c_dispatch.h"
 
 //===========================================================================
 //
@@ -125,19 +129,471 @@ enum
 
 #define CHECK_N(f) if (!(namespace_bits&(f))) break;
 
+//===========================================================================
+//
+// FUDMFScanner
+//
+//===========================================================================
+
+//===========================================================================
+//
+// Takes over the lump's data. A 0 is appended so that the last token
+// can be terminated like all the others.
+//
+//===========================================================================
+
+void FUDMFScanner::OpenMem(const char *name, TArray<uint8_t> &&buffer)
+{
+	ScriptName = name;
+	Buffer = std::move(buffer);
+	Buffer.Push(0);
+	ScanPos = 0;
+	ScanLine = 1;
+	NumChunks = ChunkIndex = TokenIndex = TotalTokens = 0;
+	AlreadyGot = false;
+	String = Punct;
+	TokenType = 0;
+	Line = 1;
+}
+
+//===========================================================================
+//
+// Returns the end of the first block that ends at least ChunkSize bytes
+// after start, so that no token or block can cross a chunk boundary.
+//
+//===========================================================================
+
+uint32_t FUDMFScanner::FindChunkEnd(uint32_t start, int &lines)
+{
+	const uint8_t *text = Buffer.Data();
+	uint32_t size = Buffer.Size() - 1;
+	uint32_t p = start;
+	int depth = 0;
+
+	lines = 0;
+	while (p < size)
+	{
+		uint8_t c = text[p++];
+
+		if (c == '\n')
+		{
+			lines++;
+		}
+		else if (c == '"')
+		{
+			while (p < size && text[p] != '"')
+			{
+				if (text[p] == '\\' && p + 1 < size) p++;
+				if (text[p] == '\n') lines++;
+				p++;
+			}
+			p++;
+		}
+		else if (c == '/' && text[p] == '/')
+		{
+			while (p < size && text[p] != '\n') p++;
+		}
+		else if (c == '/' && text[p] == '*')
+		{
+			p++;
+			while (p < size && !(text[p] == '*' && text[p + 1] == '/'))
+			{
+				if (text[p] == '\n') lines++;
+				p++;
+			}
+			p += 2;
+		}
+		else if (c == '{')
+		{
+			depth++;
+		}
+		else if (c == '}')
+		{
+			if (depth > 0) depth--;
+			if (depth == 0 && p - start >= ChunkSize) break;
+		}
+	}
+	return MIN(p, size);
+}
+
+//===========================================================================
+//
+// Splits one chunk into tokens. This may run on any thread: it only
+// writes to the chunk and to the part of the buffer the chunk covers.
+//
+//===========================================================================
+
+void FUDMFScanner::Tokenize(FChunk &chunk)
+{
+	char *text = (char *)Buffer.Data();
+	uint32_t p = chunk.Start;
+	uint32_t end = chunk.End;
+	int line = chunk.Line;
+
+	chunk.Tokens.Clear();
+	while (p < end)
+	{
+		char c = text[p];
+
+		if (c == '\n')
+		{
+			line++;
+			p++;
+			continue;
+		}
+		if (isspace((uint8_t)c))
+		{
+			p++;
+			continue;
+		}
+		if (c == '/' && text[p + 1] == '/')
+		{
+			while (p < end && text[p] != '\n') p++;
+			continue;
+		}
+		if (c == '/' && text[p + 1] == '*')
+		{
+			p += 2;
+			while (p < end && !(text[p] == '*' && text[p + 1] == '/'))
+			{
+				if (text[p] == '\n') line++;
+				p++;
+			}
+			p += 2;
+			continue;
+		}
+
+		FToken &tok = chunk.Tokens[chunk.Tokens.Reserve(1)];
+		tok.Offset = p;
+		tok.Line = line;
+		tok.Number = 0;
+		tok.Float = 0;
+
+		if (isalpha((uint8_t)c) || c == '_')
+		{
+			while (isalnum((uint8_t)text[p]) || text[p] == '_') p++;
+			tok.End = p;
+			size_t len = p - tok.Offset;
+			if (len == 4 && !strnicmp(text + tok.Offset, "true", 4)) tok.Type = TK_True;
+			else if (len == 5 && !strnicmp(text + tok.Offset, "false", 5)) tok.Type = TK_False;
+			else tok.Type = TK_Identifier;
+			// Only existing names can be looked up here. New ones are created later, on the main thread.
+			tok.Number = FName(text + tok.Offset, len, true).GetIndex();
+		}
+		else if (isdigit((uint8_t)c) || (c == '.' && isdigit((uint8_t)text[p + 1])))
+		{
+			char *stopper;
+			bool isfloat = false;
+
+			if (c == '0' && (text[p + 1] == 'x' || text[p + 1] == 'X'))
+			{
+				p += 2;
+				while (isxdigit((uint8_t)text[p])) p++;
+			}
+			else
+			{
+				while (isdigit((uint8_t)text[p])) p++;
+				if (text[p] == '.')
+				{
+					isfloat = true;
+					p++;
+					while (isdigit((uint8_t)text[p])) p++;
+				}
+				if ((text[p] == 'e' || text[p] == 'E') &&
+					(isdigit((uint8_t)text[p + 1]) || ((text[p + 1] == '+' || text[p + 1] == '-') && isdigit((uint8_t)text[p + 2]))))
+				{
+					isfloat = true;
+					p += 2;
+					while (isdigit((uint8_t)text[p])) p++;
+				}
+			}
+			if (isfloat)
+			{
+				tok.Type = TK_FloatConst;
+				tok.Float = strtod(text + tok.Offset, &stopper);
+				if (text[p] == 'f' || text[p] == 'F') p++;
+			}
+			else
+			{
+				bool isunsigned = false;
+				while (text[p] == 'u' || text[p] == 'U' || text[p] == 'l' || text[p] == 'L')
+				{
+					isunsigned |= (text[p] == 'u' || text[p] == 'U');
+					p++;
+				}
+				if (isunsigned)
+				{
+					tok.Type = TK_UIntConst;
+					tok.Number = (int)strtoull(text + tok.Offset, &stopper, 0);
+					tok.Float = (unsigned)tok.Number;
+				}
+				else
+				{
+					tok.Type = TK_IntConst;
+					tok.Number = (int)strtoll(text + tok.Offset, &stopper, 0);
+					tok.Float = tok.Number;
+				}
+			}
+			tok.End = p;
+		}
+		else if (c == '"')
+		{
+			tok.Type = TK_StringConst;
+			tok.Offset = ++p;
+			while (p < end && text[p] != '"')
+			{
+				if (text[p] == '\\' && p + 1 < end) p++;
+				if (text[p] == '\n') line++;
+				p++;
+			}
+			tok.End = MIN(p, end);
+			p++;
+		}
+		else
+		{
+			tok.Type = (uint8_t)c;
+			tok.End = tok.Offset;
+			p++;
+		}
+	}
+
+	// Now that the chunk has been scanned the token texts can be terminated.
+	for (auto &tok : chunk.Tokens)
+	{
+		if (tok.End != tok.Offset || tok.Type == TK_StringConst)
+		{
+			text[tok.End] = 0;
+			if (tok.Type == TK_StringConst)
+			{
+				strbin(text + tok.Offset);
+			}
+		}
+	}
+}
+
+//===========================================================================
+//
+// Tokenizes the next batch of chunks.
+//
+//===========================================================================
+
+bool FUDMFScanner::Refill()
+{
+	uint32_t size = Buffer.Size() - 1;
+
+	NumChunks = ChunkIndex = TokenIndex = 0;
+	while (NumChunks < MaxChunks && ScanPos < size)
+	{
+		if (Chunks.Size() <= NumChunks) Chunks.Reserve(1);
+		FChunk &chunk = Chunks[NumChunks++];
+		int lines;
+
+		chunk.Start = ScanPos;
+		chunk.End = FindChunkEnd(ScanPos, lines);
+		chunk.Line = ScanLine;
+		ScanPos = chunk.End;
+		ScanLine += lines;
+	}
+	if (NumChunks == 0)
+	{
+		return false;
+	}
+
+	int count = NumChunks;
+	if (count == 1)
+	{
+		Tokenize(Chunks[0]);
+	}
+	else
+	{
+		parallel_for(count, [&](int i)
+		{
+			if (i < count) Tokenize(Chunks[i]);
+		});
+	}
+	return true;
+}
+
+//===========================================================================
+//
+//
+//
+//===========================================================================
+
+bool FUDMFScanner::GetToken()
+{
+	if (AlreadyGot)
+	{
+		AlreadyGot = false;
+		return true;
+	}
+	while (ChunkIndex >= NumChunks || TokenIndex >= Chunks[ChunkIndex].Tokens.Size())
+	{
+		if (ChunkIndex < NumChunks)
+		{
+			ChunkIndex++;
+			TokenIndex = 0;
+		}
+		else if (!Refill())
+		{
+			return false;
+		}
+	}
+
+	const FToken &tok = Chunks[ChunkIndex].Tokens[TokenIndex++];
+	TotalTokens++;
+	TokenType = tok.Type;
+	Line = tok.Line;
+	NameIndex = 0;
+	// Like FScanner, only numeric tokens change Number and Float. The parser
+	// reads a value's number after the terminating ';' has been scanned.
+	if (tok.Type == TK_IntConst || tok.Type == TK_UIntConst)
+	{
+		Number = tok.Number;
+		Float = tok.Float;
+	}
+	else if (tok.Type == TK_FloatConst)
+	{
+		Float = tok.Float;
+	}
+	else if (tok.Type == TK_Identifier || tok.Type == TK_True || tok.Type == TK_False)
+	{
+		NameIndex = tok.Number;
+	}
+	if (tok.End != tok.Offset || tok.Type == TK_StringConst)
+	{
+		String = (char *)Buffer.Data() + tok.Offset;
+	}
+	else
+	{
+		Punct[0] = (char)tok.Type;
+		Punct[1] = 0;
+		String = Punct;
+	}
+	return true;
+}
+
+void FUDMFScanner::MustGetAnyToken()
+{
+	if (!GetToken())
+	{
+		ScriptError("Missing token (unexpected end of file).");
+	}
+}
+
+void FUDMFScanner::MustGetToken(int token)
+{
+	MustGetAnyToken();
+	if (TokenType != token)
+	{
+		ScriptError("Expected %s but got %s instead.", FScanner::TokenName(token).GetChars(), FScanner::TokenName(TokenType, String).GetChars());
+	}
+}
+
+void FUDMFScanner::MustGetStringName(const char *name)
+{
+	MustGetString();
+	if (!Compare(name))
+	{
+		ScriptError("Expected '%s', got '%s'.", name, String);
+	}
+}
+
+bool FUDMFScanner::CheckToken(int token)
+{
+	if (GetToken())
+	{
+		if (TokenType == token)
+		{
+			return true;
+		}
+		UnGet();
+	}
+	return false;
+}
+
+bool FUDMFScanner::CheckString(const char *name)
+{
+	if (GetString())
+	{
+		if (Compare(name))
+		{
+			return true;
+		}
+		UnGet();
+	}
+	return false;
+}
+
+bool FUDMFScanner::Compare(const char *text) const
+{
+	return !stricmp(String, text);
+}
+
+//===========================================================================
+//
+// The name of the current identifier. Names that did not exist yet when
+// the token was scanned are created here.
+//
+//===========================================================================
+
+FName FUDMFScanner::GetName()
+{
+	if (NameIndex == NAME_None && stricmp(String, "None"))
+	{
+		NameIndex = FName(String).GetIndex();
+	}
+	return ENamedName(NameIndex);
+}
+
+void FUDMFScanner::ScriptMessage(const char *message, ...)
+{
+	FString composed;
+	va_list arglist;
+
+	va_start(arglist, message);
+	composed.VFormat(message, arglist);
+	va_end(arglist);
+
+	Printf(TEXTCOLOR_RED "Script error, \"%s\"" TEXTCOLOR_RED "line %d:\n" TEXTCOLOR_RED "%s\n", ScriptName.GetChars(), Line, composed.GetChars());
+}
+
+void FUDMFScanner::ScriptError(const char *message, ...)
+{
+	FString composed;
+	va_list arglist;
+
+	va_start(arglist, message);
+	composed.VFormat(message, arglist);
+	va_end(arglist);
+
+	I_Error("Script error, \"%s\" line %d:\n%s\n", ScriptName.GetChars(), Line, composed.GetChars());
+}
+
 //===========================================================================
 //
 // Common parsing routines
 //
 //===========================================================================
 
+static inline FName KeyName(FScanner &sc)
+{
+	return sc.String;
+}
+
+static inline FName KeyName(FUDMFScanner &sc)
+{
+	return sc.GetName();
+}
+
 //===========================================================================
 //
 // Skip a key or block
 //
 //===========================================================================
 
-void UDMFParserBase::Skip()
+template<class Scanner>
+void TUDMFParserBase<Scanner>::Skip()
 {
 	if (developer >= DMSG_WARNING) sc.ScriptMessage("Ignoring unknown UDMF key \"%s\".", sc.String);
 	if(sc.CheckToken('{'))
@@ -177,10 +633,11 @@ void UDMFParserBase::Skip()
 //
 //===========================================================================
 
-FName UDMFParserBase::ParseKey(bool checkblock, bool *isblock)
+template<class Scanner>
+FName TUDMFParserBase<Scanner>::ParseKey(bool checkblock, bool *isblock)
 {
 	sc.MustGetString();
-	FName key = sc.String;
+	FName key = KeyName(sc);
 	if (checkblock)
 	{
 		if (sc.CheckToken('{'))
@@ -226,7 +683,8 @@ FName UDMFParserBase::ParseKey(bool checkblock, bool *isblock)
 //
 //===========================================================================
 
-int UDMFParserBase::CheckInt(const char *key)
+template<class Scanner>
+int TUDMFParserBase<Scanner>::CheckInt(const char *key)
 {
 	if (sc.TokenType != TK_IntConst)
 	{
@@ -235,7 +693,8 @@ int UDMFParserBase::CheckInt(const char *key)
 	return sc.Number;
 }
 
-double UDMFParserBase::CheckFloat(const char *key)
+template<class Scanner>
+double TUDMFParserBase<Scanner>::CheckFloat(const char *key)
 {
 	if (sc.TokenType != TK_IntConst && sc.TokenType != TK_FloatConst)
 	{
@@ -244,7 +703,8 @@ double UDMFParserBase::CheckFloat(const char *key)
 	return sc.Float;
 }
 
-double UDMFParserBase::CheckCoordinate(const char *key)
+template<class Scanner>
+double TUDMFParserBase<Scanner>::CheckCoordinate(const char *key)
 {
 	if (sc.TokenType != TK_IntConst && sc.TokenType != TK_FloatConst)
 	{
@@ -258,12 +718,14 @@ double UDMFParserBase::CheckCoordinate(const char *key)
 	return sc.Float;
 }
 
-DAngle UDMFParserBase::CheckAngle(const char *key)
+template<class Scanner>
+DAngle TUDMFParserBase<Scanner>::CheckAngle(const char *key)
 {
 	return DAngle(CheckFloat(key)).Normalized360();
 }
 
-bool UDMFParserBase::CheckBool(const char *key)
+template<class Scanner>
+bool TUDMFParserBase<Scanner>::CheckBool(const char *key)
 {
 	if (sc.TokenType == TK_True) return true;
 	if (sc.TokenType == TK_False) return false;
@@ -271,7 +733,8 @@ bool UDMFParserBase::CheckBool(const char *key)
 	return false;
 }
 
-const char *UDMFParserBase::CheckString(const char *key)
+template<class Scanner>
+const char *TUDMFParserBase<Scanner>::CheckString(const char *key)
 {
 	if (sc.TokenType != TK_StringConst)
 	{
@@ -280,6 +743,9 @@ const char *UDMFParserBase::CheckString(const char *key)
 	return parsedString;
 }
 
+template class TUDMFParserBase<FScanner>;
+template class TUDMFParserBase<FUDMFScanner>;
+
 //===========================================================================
 //
 // Storage of UDMF user properties
@@ -398,7 +864,7 @@ struct UDMFScroll
 	FName type;
 };
 
-class UDMFParser : public UDMFParserBase
+class UDMFParser : public TUDMFParserBase<FUDMFScanner>
 {
 	bool isTranslated;
 	bool isExtended;
@@ -2121,8 +2587,9 @@ public:
 		isExtended = false;
 		floordrop = false;
 
+		uint64_t startTime = I_msTime();
+
 		sc.OpenMem(Wads.GetLumpFullName(map->lumpnum), map->Read(ML_TEXTMAP));
-		sc.SetCMode(true);
 		if (sc.CheckString("namespace"))
 		{
 			sc.MustGetStringName("=");
@@ -2248,6 +2715,8 @@ public:
 			}
 		}
 
+		DPrintf(DMSG_NOTIFY, "TEXTMAP parsing took %.3f sec (%u tokens)\n", (I_msTime() - startTime) * 0.001, sc.NumTokens());
+
 		// Catch bogus maps here rather than during nodebuilding
 		if (ParsedVertices.Size() == 0)	I_Error("Map has no vertices.");
 		if (ParsedSectors.Size() == 0)	I_Error("Map has no sectors. ");
@@ -2293,3 +2762,65 @@ void MapLoader::ParseTextMap(MapData *map, FMissingTextureTracker &missingtex)
 
 	parse.ParseTextMap(map);
 }
+
+//===========================================================================
+//
+// Checks FUDMFScanner against FScanner on the TEXTMAP of the given maps.
+// The parser reads a value's number after the following token, so the
+// entire scanner state gets compared after every token, not just the
+// token that set it.
+//
+//===========================================================================
+
+CCMD(udmfscancheck)
+{
+	if (argv.argc() < 2)
+	{
+		Printf("Usage: udmfscancheck <map> ...\n");
+		return;
+	}
+	for (int i = 1; i < argv.argc(); i++)
+	{
+		MapData *map = P_OpenMapData(argv[i], true);
+		if (map == nullptr || !map->isText)
+		{
+			Printf("%s is not a UDMF map\n", argv[i]);
+			delete map;
+			continue;
+		}
+
+		FScanner ref;
+		FUDMFScanner sc;
+		auto text = map->Read(ML_TEXTMAP);
+		ref.OpenMem(argv[i], text);
+		ref.SetCMode(true);
+		sc.OpenMem(argv[i], std::move(text));
+		delete map;
+
+		unsigned count = 0;
+		bool ok = true;
+		while (ok)
+		{
+			bool gotref = ref.GetToken();
+			bool got = sc.GetToken();
+			if (!gotref || !got)
+			{
+				ok = gotref == got;
+				break;
+			}
+			count++;
+			// FScanner knows more keywords, UDMF treats them all as identifiers.
+			bool sametype = sc.TokenType == ref.TokenType || (sc.TokenType == TK_Identifier && ref.TokenType > TK_NonWhitespace);
+			ok = sametype && !strcmp(sc.String, ref.String) && sc.Line == ref.Line && sc.Number == ref.Number && sc.Float == ref.Float;
+		}
+		if (ok)
+		{
+			Printf("%s: %u tokens, no differences\n", argv[i], count);
+		}
+		else
+		{
+			Printf(TEXTCOLOR_RED "%s: difference at token %u, line %d: '%s' (type %d, %d, %g), FScanner has '%s' (type %d, %d, %g)\n", argv[i], count,
+				ref.Line, sc.String, sc.TokenType, sc.Number, sc.Float, ref.String, ref.TokenType, ref.Number, ref.Float);
+		}
+	}
+}
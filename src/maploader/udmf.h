@@ -4,10 +4,93 @@
 #include "sc_man.h"
 #include "m_fixed.h"
 
-class UDMFParserBase
+//===========================================================================
+//
+// A scanner for TEXTMAP lumps. UDMF only has a handful of token types, so
+// instead of going through FScanner it splits the lump into ranges of whole
+// blocks and tokenizes a batch of those ranges in parallel. Token texts
+// stay in the lump buffer; numbers and key names are already decoded when
+// the parser gets to them.
+//
+// It implements the parts of FScanner's interface the UDMF parser uses.
+//
+//===========================================================================
+
+class FUDMFScanner
+{
+public:
+	char *String = nullptr;
+	int TokenType = 0;
+	int Number = 0;
+	double Float = 0;
+	int Line = 1;
+
+	void OpenMem(const char *name, TArray<uint8_t> &&buffer);
+
+	bool GetToken();
+	bool GetString() { return GetToken(); }
+	void MustGetAnyToken();
+	void MustGetString() { MustGetAnyToken(); }
+	void MustGetToken(int token);
+	void MustGetStringName(const char *name);
+	bool CheckToken(int token);
+	bool CheckString(const char *name);
+	bool Compare(const char *text) const;
+	void UnGet() { AlreadyGot = true; }
+	FName GetName();
+
+	void ScriptMessage(const char *message, ...) GCCPRINTF(2,3);
+	void ScriptError(const char *message, ...) GCCPRINTF(2,3);
+
+	unsigned NumTokens() const { return TotalTokens; }
+
+private:
+	struct FToken
+	{
+		uint32_t Offset;	// start of the text (for strings, without the quote)
+		uint32_t End;		// where the text's terminating 0 goes
+		int Line;
+		int Type;
+		int Number;			// or the name index for identifiers
+		double Float;
+	};
+
+	struct FChunk
+	{
+		uint32_t Start, End;
+		int Line;
+		TArray<FToken> Tokens;
+	};
+
+	enum
+	{
+		ChunkSize = 65536,	// Bytes of text per chunk, rounded up to the next block end
+		MaxChunks = 32,		// Chunks tokenized in one go
+	};
+
+	FString ScriptName;
+	TArray<uint8_t> Buffer;
+	uint32_t ScanPos = 0;		// start of the next chunk
+	int ScanLine = 1;
+	TArray<FChunk> Chunks;
+	unsigned NumChunks = 0;
+	unsigned ChunkIndex = 0;
+	unsigned TokenIndex = 0;
+	unsigned TotalTokens = 0;
+	bool AlreadyGot = false;
+	int NameIndex = 0;
+	char Punct[2] = {};
+
+	uint32_t FindChunkEnd(uint32_t start, int &lines);
+	void Tokenize(FChunk &chunk);
+	bool Refill();
+};
+
+template<class Scanner>
+class TUDMFParserBase
 {
 protected:
-	FScanner sc;
+	Scanner sc;
 	FName namespc = NAME_None;
 	int namespace_bits;
 	FString parsedString;
@@ -33,6 +116,9 @@ protected:
 
 };
 
+// USDF lumps are small, so they are still read with FScanner.
+typedef TUDMFParserBase<FScanner> UDMFParserBase;
+
 #define BLOCK_ID (ENamedName)-1
 
 #endif
\ No newline at end of file
@@ -3641,6 +3641,22 @@ do_count:
 			}
 		}
 	}
+	else if (kind != NULL)
+	{
+		auto list = Level->GetActorsOfClass(kind);
+		if (list != nullptr)
+		{
+			for (auto actor : *list)
+			{
+				if (actor->health > 0 &&
+					(tag == -1 || Level->SectorHasTag(actor->Sector, tag)) &&
+					actor->IsMapActor())
+				{
+					count++;
+				}
+			}
+		}
+	}
 	else
 	{
 		auto iterator = Level->GetThinkerIterator<AActor>();
@@ -6739,6 +6755,50 @@ inline int getshort (int *&pc)
 	return res;
 }
 
+inline int getpcode (int *&pc, ACSFormat fmt)
+{
+	if (fmt == ACS_LittleEnhanced)
+	{
+		int pcd = getbyte(pc);
+		if (pcd >= 256-16)
+		{
+			pcd = (256-16) + ((pcd - (256-16)) << 8) + getbyte(pc);
+		}
+		return pcd;
+	}
+	return NEXTWORD;
+}
+
+//==========================================================================
+//
+// With GCC-compatible compilers the most frequent p-codes are dispatched
+// through a table of label addresses, like the VM interpreter does it.
+// Their handlers jump straight to the next instruction's handler instead
+// of going back through the switch, which gives each of them its own
+// branch prediction for the following p-code.
+// These handlers must not change the script's state.
+//
+// This only changes how the p-codes are dispatched. They and their operands
+// are still decoded from the module as they get executed, because script
+// addresses, jump targets and the pc stored in savegames are all offsets
+// into the original p-code.
+//
+//==========================================================================
+
+#if !defined(COMPGOTO) && defined(__GNUC__)
+#define COMPGOTO 1
+#endif
+
+#if COMPGOTO
+#define OPCODE(x)	case x: L_##x
+#define THREADED(x)	dispatch[x] = &&L_##x;
+#define DISPATCH	if ((unsigned)pcd < PCODE_COMMAND_COUNT && dispatch[pcd] != nullptr) goto *dispatch[pcd]; else goto dispatch_switch;
+#define NEXTOP		{ if (runaway >= 2000000) break; runaway++; pcd = getpcode(pc, fmt); DISPATCH }
+#else
+#define OPCODE(x)	case x
+#define NEXTOP		break
+#endif
+
 static bool CharArrayParms(int &capacity, int &offset, int &a, FACSStackMemory& Stack, int &sp, bool ranged)
 {
 	if (ranged)
@@ -6778,6 +6838,9 @@ int DLevelScript::RunScript()
 	FRemapTable *translation = 0;
 	int resultValue = 1;
 
+	// Scripts can toggle line flags and 3D floors without going through a special.
+	Level->SightPrecalc.Invalidate();
+
 	if (InModuleScriptNumber >= 0)
 	{
 		ScriptPtr *ptr = activeBehavior->GetScriptPtr(InModuleScriptNumber);
@@ -6858,6 +6921,23 @@ int DLevelScript::RunScript()
 	int optstart = -1;
 	int temp;
 
+#if COMPGOTO
+	static const void *dispatch[PCODE_COMMAND_COUNT];
+	if (dispatch[PCD_NOP] == nullptr)
+	{
+		THREADED(PCD_NOP) THREADED(PCD_PUSHNUMBER) THREADED(PCD_PUSHBYTE) THREADED(PCD_DUP) THREADED(PCD_SWAP) THREADED(PCD_DROP)
+		THREADED(PCD_ADD) THREADED(PCD_SUBTRACT) THREADED(PCD_MULTIPLY)
+		THREADED(PCD_EQ) THREADED(PCD_NE) THREADED(PCD_LT) THREADED(PCD_GT) THREADED(PCD_LE) THREADED(PCD_GE)
+		THREADED(PCD_ANDLOGICAL) THREADED(PCD_ORLOGICAL) THREADED(PCD_NEGATELOGICAL)
+		THREADED(PCD_ASSIGNSCRIPTVAR) THREADED(PCD_ASSIGNMAPVAR) THREADED(PCD_ASSIGNSCRIPTARRAY)
+		THREADED(PCD_PUSHSCRIPTVAR) THREADED(PCD_PUSHMAPVAR) THREADED(PCD_PUSHWORLDVAR) THREADED(PCD_PUSHGLOBALVAR)
+		THREADED(PCD_PUSHSCRIPTARRAY) THREADED(PCD_PUSHMAPARRAY)
+		THREADED(PCD_ADDSCRIPTVAR) THREADED(PCD_ADDMAPVAR) THREADED(PCD_INCSCRIPTVAR) THREADED(PCD_INCMAPVAR)
+		THREADED(PCD_DECSCRIPTVAR) THREADED(PCD_DECMAPVAR)
+		THREADED(PCD_GOTO) THREADED(PCD_IFGOTO) THREADED(PCD_IFNOTGOTO) THREADED(PCD_CASEGOTO)
+	}
+#endif
+
 	while (state == SCRIPT_Running)
 	{
 		if (++runaway > 2000000)
@@ -6867,19 +6947,11 @@ int DLevelScript::RunScript()
 			break;
 		}
 
-		if (fmt == ACS_LittleEnhanced)
-		{
-			pcd = getbyte(pc);
-			if (pcd >= 256-16)
-			{
-				pcd = (256-16) + ((pcd - (256-16)) << 8) + getbyte(pc);
-			}
-		}
-		else
-		{
-			pcd = NEXTWORD;
-		}
-
+		pcd = getpcode(pc, fmt);
+#if COMPGOTO
+		DISPATCH
+dispatch_switch:
+#endif
 		switch (pcd)
 		{
 		default:
@@ -6891,8 +6963,8 @@ int DLevelScript::RunScript()
 			state = SCRIPT_PleaseRemove;
 			break;
 
-		case PCD_NOP:
-			break;
+		OPCODE(PCD_NOP):
+			NEXTOP;
 
 		case PCD_SUSPEND:
 			state = SCRIPT_Suspended;
@@ -6903,15 +6975,15 @@ int DLevelScript::RunScript()
 			Stack[sp-1] = GlobalACSStrings.AddString(activeBehavior->LookupString(Stack[sp-1]));
 			break;
 
-		case PCD_PUSHNUMBER:
+		OPCODE(PCD_PUSHNUMBER):
 			PushToStack (uallong(pc[0]));
 			pc++;
-			break;
+			NEXTOP;
 
-		case PCD_PUSHBYTE:
+		OPCODE(PCD_PUSHBYTE):
 			PushToStack (*(uint8_t *)pc);
 			pc = (int *)((uint8_t *)pc + 1);
-			break;
+			NEXTOP;
 
 		case PCD_PUSH2BYTES:
 			Stack[sp] = ((uint8_t *)pc)[0];
@@ -6956,14 +7028,14 @@ int DLevelScript::RunScript()
 			}
 			break;
 
-		case PCD_DUP:
+		OPCODE(PCD_DUP):
 			Stack[sp] = Stack[sp-1];
 			sp++;
-			break;
+			NEXTOP;
 
-		case PCD_SWAP:
+		OPCODE(PCD_SWAP):
 			swapvalues(Stack[sp-2], Stack[sp-1]);
-			break;
+			NEXTOP;
 
 		case PCD_LSPEC1:
 			P_ExecuteSpecial(Level, NEXTBYTE, activationline, activator, backSide,
@@ -7223,20 +7295,20 @@ int DLevelScript::RunScript()
 			}
 			break;
 
-		case PCD_ADD:
+		OPCODE(PCD_ADD):
 			STACK(2) = STACK(2) + STACK(1);
 			sp--;
-			break;
+			NEXTOP;
 
-		case PCD_SUBTRACT:
+		OPCODE(PCD_SUBTRACT):
 			STACK(2) = STACK(2) - STACK(1);
 			sp--;
-			break;
+			NEXTOP;
 
-		case PCD_MULTIPLY:
+		OPCODE(PCD_MULTIPLY):
 			STACK(2) = STACK(2) * STACK(1);
 			sp--;
-			break;
+			NEXTOP;
 
 		case PCD_DIVIDE:
 			if (STACK(1) == 0)
@@ -7262,46 +7334,46 @@ int DLevelScript::RunScript()
 			}
 			break;
 
-		case PCD_EQ:
+		OPCODE(PCD_EQ):
 			STACK(2) = (STACK(2) == STACK(1));
 			sp--;
-			break;
+			NEXTOP;
 
-		case PCD_NE:
+		OPCODE(PCD_NE):
 			STACK(2) = (STACK(2) != STACK(1));
 			sp--;
-			break;
+			NEXTOP;
 
-		case PCD_LT:
+		OPCODE(PCD_LT):
 			STACK(2) = (STACK(2) < STACK(1));
 			sp--;
-			break;
+			NEXTOP;
 
-		case PCD_GT:
+		OPCODE(PCD_GT):
 			STACK(2) = (STACK(2) > STACK(1));
 			sp--;
-			break;
+			NEXTOP;
 
-		case PCD_LE:
+		OPCODE(PCD_LE):
 			STACK(2) = (STACK(2) <= STACK(1));
 			sp--;
-			break;
+			NEXTOP;
 
-		case PCD_GE:
+		OPCODE(PCD_GE):
 			STACK(2) = (STACK(2) >= STACK(1));
 			sp--;
-			break;
+			NEXTOP;
 
-		case PCD_ASSIGNSCRIPTVAR:
+		OPCODE(PCD_ASSIGNSCRIPTVAR):
 			locals[NEXTBYTE] = STACK(1);
 			sp--;
-			break;
+			NEXTOP;
 
 
-		case PCD_ASSIGNMAPVAR:
+		OPCODE(PCD_ASSIGNMAPVAR):
 			*(activeBehavior->MapVars[NEXTBYTE]) = STACK(1);
 			sp--;
-			break;
+			NEXTOP;
 
 		case PCD_ASSIGNWORLDVAR:
 			ACS_WorldVars[NEXTBYTE] = STACK(1);
@@ -7313,10 +7385,10 @@ int DLevelScript::RunScript()
 			sp--;
 			break;
 
-		case PCD_ASSIGNSCRIPTARRAY:
+		OPCODE(PCD_ASSIGNSCRIPTARRAY):
 			localarrays->Set(locals, NEXTBYTE, STACK(2), STACK(1));
 			sp -= 2;
-			break;
+			NEXTOP;
 
 		case PCD_ASSIGNMAPARRAY:
 			activeBehavior->SetArrayVal (*(activeBehavior->MapVars[NEXTBYTE]), STACK(2), STACK(1));
@@ -7333,29 +7405,29 @@ int DLevelScript::RunScript()
 			sp -= 2;
 			break;
 
-		case PCD_PUSHSCRIPTVAR:
+		OPCODE(PCD_PUSHSCRIPTVAR):
 			PushToStack (locals[NEXTBYTE]);
-			break;
+			NEXTOP;
 
-		case PCD_PUSHMAPVAR:
+		OPCODE(PCD_PUSHMAPVAR):
 			PushToStack (*(activeBehavior->MapVars[NEXTBYTE]));
-			break;
+			NEXTOP;
 
-		case PCD_PUSHWORLDVAR:
+		OPCODE(PCD_PUSHWORLDVAR):
 			PushToStack (ACS_WorldVars[NEXTBYTE]);
-			break;
+			NEXTOP;
 
-		case PCD_PUSHGLOBALVAR:
+		OPCODE(PCD_PUSHGLOBALVAR):
 			PushToStack (ACS_GlobalVars[NEXTBYTE]);
-			break;
+			NEXTOP;
 
-		case PCD_PUSHSCRIPTARRAY:
+		OPCODE(PCD_PUSHSCRIPTARRAY):
 			STACK(1) = localarrays->Get(locals, NEXTBYTE, STACK(1));
-			break;
+			NEXTOP;
 
-		case PCD_PUSHMAPARRAY:
+		OPCODE(PCD_PUSHMAPARRAY):
 			STACK(1) = activeBehavior->GetArrayVal (*(activeBehavior->MapVars[NEXTBYTE]), STACK(1));
-			break;
+			NEXTOP;
 
 		case PCD_PUSHWORLDARRAY:
 			STACK(1) = ACS_WorldArrays[NEXTBYTE][STACK(1)];
@@ -7365,15 +7437,15 @@ int DLevelScript::RunScript()
 			STACK(1) = ACS_GlobalArrays[NEXTBYTE][STACK(1)];
 			break;
 
-		case PCD_ADDSCRIPTVAR:
+		OPCODE(PCD_ADDSCRIPTVAR):
 			locals[NEXTBYTE] += STACK(1);
 			sp--;
-			break;
+			NEXTOP;
 
-		case PCD_ADDMAPVAR:
+		OPCODE(PCD_ADDMAPVAR):
 			*(activeBehavior->MapVars[NEXTBYTE]) += STACK(1);
 			sp--;
-			break;
+			NEXTOP;
 
 		case PCD_ADDWORLDVAR:
 			ACS_WorldVars[NEXTBYTE] += STACK(1);
@@ -7994,13 +8066,13 @@ int DLevelScript::RunScript()
 			break;
 		//[MW] end
 
-		case PCD_INCSCRIPTVAR:
+		OPCODE(PCD_INCSCRIPTVAR):
 			++locals[NEXTBYTE];
-			break;
+			NEXTOP;
 
-		case PCD_INCMAPVAR:
+		OPCODE(PCD_INCMAPVAR):
 			*(activeBehavior->MapVars[NEXTBYTE]) += 1;
-			break;
+			NEXTOP;
 
 		case PCD_INCWORLDVAR:
 			++ACS_WorldVars[NEXTBYTE];
@@ -8043,13 +8115,13 @@ int DLevelScript::RunScript()
 			}
 			break;
 
-		case PCD_DECSCRIPTVAR:
+		OPCODE(PCD_DECSCRIPTVAR):
 			--locals[NEXTBYTE];
-			break;
+			NEXTOP;
 
-		case PCD_DECMAPVAR:
+		OPCODE(PCD_DECMAPVAR):
 			*(activeBehavior->MapVars[NEXTBYTE]) -= 1;
-			break;
+			NEXTOP;
 
 		case PCD_DECWORLDVAR:
 			--ACS_WorldVars[NEXTBYTE];
@@ -8093,28 +8165,28 @@ int DLevelScript::RunScript()
 			}
 			break;
 
-		case PCD_GOTO:
+		OPCODE(PCD_GOTO):
 			pc = activeBehavior->Ofs2PC (LittleLong(*pc));
-			break;
+			NEXTOP;
 
 		case PCD_GOTOSTACK:
 			pc = activeBehavior->Jump2PC (STACK(1));
 			sp--;
 			break;
 
-		case PCD_IFGOTO:
+		OPCODE(PCD_IFGOTO):
 			if (STACK(1))
 				pc = activeBehavior->Ofs2PC (LittleLong(*pc));
 			else
 				pc++;
 			sp--;
-			break;
+			NEXTOP;
 
 		case PCD_SETRESULTVALUE:
 			resultValue = STACK(1);
-		case PCD_DROP: //fall through.
+		OPCODE(PCD_DROP): //fall through.
 			sp--;
-			break;
+			NEXTOP;
 
 		case PCD_DELAY:
 			statedata = STACK(1) + (fmt == ACS_Old && gameinfo.gametype == GAME_Hexen);
@@ -8236,15 +8308,15 @@ int DLevelScript::RunScript()
 			}
 			break;
 
-		case PCD_ANDLOGICAL:
+		OPCODE(PCD_ANDLOGICAL):
 			STACK(2) = (STACK(2) && STACK(1));
 			sp--;
-			break;
+			NEXTOP;
 
-		case PCD_ORLOGICAL:
+		OPCODE(PCD_ORLOGICAL):
 			STACK(2) = (STACK(2) || STACK(1));
 			sp--;
-			break;
+			NEXTOP;
 
 		case PCD_ANDBITWISE:
 			STACK(2) = (STACK(2) & STACK(1));
@@ -8261,9 +8333,9 @@ int DLevelScript::RunScript()
 			sp--;
 			break;
 
-		case PCD_NEGATELOGICAL:
+		OPCODE(PCD_NEGATELOGICAL):
 			STACK(1) = !STACK(1);
-			break;
+			NEXTOP;
 
 
 
@@ -8286,13 +8358,13 @@ int DLevelScript::RunScript()
 			STACK(1) = -STACK(1);
 			break;
 
-		case PCD_IFNOTGOTO:
+		OPCODE(PCD_IFNOTGOTO):
 			if (!STACK(1))
 				pc = activeBehavior->Ofs2PC (LittleLong(*pc));
 			else
 				pc++;
 			sp--;
-			break;
+			NEXTOP;
 
 		case PCD_LINESIDE:
 			PushToStack (backSide);
@@ -8327,7 +8399,7 @@ scriptwait:
 			}
 			break;
 
-		case PCD_CASEGOTO:
+		OPCODE(PCD_CASEGOTO):
 			if (STACK(1) == uallong(pc[0]))
 			{
 				pc = activeBehavior->Ofs2PC (uallong(pc[1]));
@@ -8337,7 +8409,7 @@ scriptwait:
 			{
 				pc += 2;
 			}
-			break;
+			NEXTOP;
 
 		case PCD_CASEGOTOSORTED:
 			// The count and jump table are 4-byte aligned
@@ -10217,6 +10289,10 @@ scriptwait:
 }
 
 #undef PushtoStack
+#undef OPCODE
+#undef NEXTOP
+#undef THREADED
+#undef DISPATCH
 
 static DLevelScript *P_GetScriptGoing (FLevelLocals *l, AActor *who, line_t *where, int num, const ScriptPtr *code, FBehavior *module,
 	const int *args, int argcount, int flags)
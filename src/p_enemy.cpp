@@ -150,24 +150,87 @@ static void NoiseMarkSector(sector_t *sec, AActor *soundtarget, bool splash, AAc
 }
 
 
+//----------------------------------------------------------------------------
+//
+// The lines a noise can travel through only depend on the map's layout,
+// so they get collected once per level, along with the sectors that are
+// found behind plane portals (which requires a costly PointInSector per
+// line). Everything that can change at run time, i.e. line flags, line
+// portals and whether a door is closed, is still checked for each alert.
+//
+//----------------------------------------------------------------------------
+
+static void BuildNoiseGraph(FLevelLocals *Level)
+{
+	auto &graph = Level->NoiseGraph;
+	auto &start = Level->NoiseGraphStart;
+
+	graph.Clear();
+	start.Resize(Level->sectors.Size() + 1);
+	Level->NoiseGraphPortals.Resize(Level->sectors.Size() * 2);
+
+	for (auto &sec : Level->sectors)
+	{
+		start[sec.Index()] = graph.Size();
+		Level->NoiseGraphPortals[sec.Index() * 2] = Level->NoiseGraphPortals[sec.Index() * 2 + 1] = UINT_MAX;
+
+		for (auto check : sec.Lines)
+		{
+			FNoiseEdge edge = { check, nullptr, nullptr, nullptr };
+
+			// Early out for one-sided and intra-sector lines
+			if (check->sidedef[1] != nullptr && check->sidedef[0]->sector != check->sidedef[1]->sector)
+			{
+				edge.other = check->sidedef[0]->sector == &sec ? check->sidedef[1]->sector : check->sidedef[0]->sector;
+			}
+			graph.Push(edge);
+		}
+	}
+	start[Level->sectors.Size()] = graph.Size();
+}
+
+static void UpdateNoisePortals(sector_t *sec, int plane)
+{
+	auto Level = sec->Level;
+	unsigned &portal = Level->NoiseGraphPortals[sec->Index() * 2 + plane];
+
+	if (portal != sec->Portals[plane])
+	{
+		// I wish there was a better method to do this than randomly looking through the portal at a few places...
+		DVector2 disp = sec->GetPortalDisplacement(plane);
+		for (unsigned i = Level->NoiseGraphStart[sec->Index()]; i < Level->NoiseGraphStart[sec->Index() + 1]; i++)
+		{
+			auto &edge = Level->NoiseGraph[i];
+			sector_t *s = Level->PointInSector(edge.line->v1->fPos() + edge.line->Delta() / 2 + disp);
+			if (plane == sector_t::ceiling) edge.upper = s;
+			else edge.lower = s;
+		}
+		portal = sec->Portals[plane];
+	}
+}
+
 static void P_RecursiveSound(sector_t *sec, AActor *soundtarget, bool splash, AActor *emitter, int soundblocks, double maxdist)
 {
+	auto Level = sec->Level;
 	bool checkabove = !sec->PortalBlocksSound(sector_t::ceiling);
 	bool checkbelow = !sec->PortalBlocksSound(sector_t::floor);
 
-	for (auto check : sec->Lines)
+	if (checkabove) UpdateNoisePortals(sec, sector_t::ceiling);
+	if (checkbelow) UpdateNoisePortals(sec, sector_t::floor);
+
+	for (unsigned i = Level->NoiseGraphStart[sec->Index()]; i < Level->NoiseGraphStart[sec->Index() + 1]; i++)
 	{
+		auto &edge = Level->NoiseGraph[i];
+		auto check = edge.line;
+
 		// check sector portals
-		// I wish there was a better method to do this than randomly looking through the portal at a few places...
 		if (checkabove)
 		{
-			sector_t *upper = sec->Level->PointInSector(check->v1->fPos() + check->Delta() / 2 + sec->GetPortalDisplacement(sector_t::ceiling));
-			NoiseMarkSector(upper, soundtarget, splash, emitter, soundblocks, maxdist);
+			NoiseMarkSector(edge.upper, soundtarget, splash, emitter, soundblocks, maxdist);
 		}
 		if (checkbelow)
 		{
-			sector_t *lower = sec->Level->PointInSector(check->v1->fPos() + check->Delta() / 2 + sec->GetPortalDisplacement(sector_t::floor));
-			NoiseMarkSector(lower, soundtarget, splash, emitter, soundblocks, maxdist);
+			NoiseMarkSector(edge.lower, soundtarget, splash, emitter, soundblocks, maxdist);
 		}
 
 		// ... and line portals;
@@ -180,22 +243,12 @@ static void P_RecursiveSound(sector_t *sec, AActor *soundtarget, bool splash, AA
 			}
 		}
 
-
-		if (check->sidedef[1] == NULL ||
-			!(check->flags & ML_TWOSIDED))
+		sector_t *other = edge.other;
+		if (other == nullptr || !(check->flags & ML_TWOSIDED))
 		{
 			continue;
 		}
 
-		// Early out for intra-sector lines
-		if (check->sidedef[0]->sector == check->sidedef[1]->sector) continue;
-
-		sector_t *other;
-		if (check->sidedef[0]->sector == sec)
-			other = check->sidedef[1]->sector;
-		else
-			other = check->sidedef[0]->sector;
-
 		// check for closed door
 		if ((sec->floorplane.ZatPoint(check->v1->fPos()) >=
 			other->ceilingplane.ZatPoint(check->v1->fPos()) &&
@@ -245,6 +298,11 @@ void P_NoiseAlert (AActor *emitter, AActor *target, bool splash, double maxdist)
 	if (target != NULL && target->player && (target->player->cheats & CF_NOTARGET))
 		return;
 
+	if (emitter->Level->NoiseGraphStart.Size() != emitter->Level->sectors.Size() + 1)
+	{
+		BuildNoiseGraph(emitter->Level);
+	}
+
 	validcount++;
 	NoiseList.Clear();
 	NoiseMarkSector(emitter->Sector, target, splash, emitter, 0, maxdist);
@@ -3047,17 +3105,17 @@ int CheckBossDeath (AActor *actor)
 		return false; // no one left alive, so do not end game
 	
 	// Make sure all bosses are dead
-	auto iterator = actor->Level->GetThinkerIterator<AActor>();
-	AActor *other;
-
-	while ( (other = iterator.Next ()) )
+	auto list = actor->Level->GetActorsOfClass(actor->GetClass());
+	if (list != nullptr)
 	{
-		if (other != actor &&
-			(other->health > 0 || (other->flags & MF_ICECORPSE))
-			&& other->GetClass() == actor->GetClass())
-		{ // Found a living boss
-		  // [RH] Frozen bosses don't count as dead until they shatter
-			return false;
+		for (auto other : *list)
+		{
+			if (other != actor &&
+				(other->health > 0 || (other->flags & MF_ICECORPSE)))
+			{ // Found a living boss
+			  // [RH] Frozen bosses don't count as dead until they shatter
+				return false;
+			}
 		}
 	}
 	// The boss death is good
@@ -3933,6 +3933,8 @@ int P_ExecuteSpecial(FLevelLocals *Level, int			num,
 {
 	if (num >= 0 && num < (int)countof(LineSpecials))
 	{
+		// Specials can change anything about the map that affects sight.
+		Level->SightPrecalc.Invalidate();
 		return LineSpecials[num](Level, line, activator, backSide, arg1, arg2, arg3, arg4, arg5);
 	}
 	return 0;
@@ -92,6 +92,7 @@
 #include "r_sky.h"
 #include "g_levellocals.h"
 #include "actorinlines.h"
+#include "stats.h"
 #include <hwrenderer\utility\hw_vrmodes.h>
 
 
@@ -5771,6 +5772,55 @@ static double GetRadiusDamage(bool fromaction, AActor *bombspot, AActor *thing,
 	return points;
 }
 
+//==========================================================================
+//
+// RadiusAttackSight
+//
+// The sight check between a radius attack and one of its victims. Another
+// explosion at the same spot can reuse the result as long as it is certain
+// to be the same as a new check's.
+//
+//==========================================================================
+
+static bool RadiusAttackSight(AActor *bombspot, AActor *thing)
+{
+	auto Level = bombspot->Level;
+	auto &cache = Level->RadiusSightCache;
+
+	if (cache.bombspot != bombspot || cache.spotpos != bombspot->Pos() || cache.spotheight != bombspot->Height ||
+		cache.maptime != Level->maptime || cache.generation != Level->SightPrecalc.generation || cache.scriptcalls != VMScriptCallCount)
+	{
+		cache.Clear();
+		cache.bombspot = bombspot;
+		cache.spotpos = bombspot->Pos();
+		cache.spotheight = bombspot->Height;
+		cache.maptime = Level->maptime;
+		cache.generation = Level->SightPrecalc.generation;
+		cache.scriptcalls = VMScriptCallCount;
+	}
+
+	auto index = cache.index.CheckKey(thing);
+	if (index != nullptr)
+	{
+		auto &entry = cache.entries[*index];
+		if (entry.thing == thing && entry.pos == thing->Pos() && entry.height == thing->Height)
+		{
+			return entry.result;
+		}
+	}
+
+	bool result = !!P_CheckSight(thing, bombspot, SF_IGNOREVISIBILITY | SF_IGNOREWATERBOUNDARY);
+	if (index != nullptr)
+	{
+		cache.entries[*index] = { thing, thing->Pos(), thing->Height, result };
+	}
+	else
+	{
+		cache.index[thing] = cache.entries.Push({ thing, thing->Pos(), thing->Height, result });
+	}
+	return result;
+}
+
 //==========================================================================
 //
 // P_GetOldRadiusDamage
@@ -5801,7 +5851,7 @@ static int GetOldRadiusDamage(bool fromaction, AActor *bombspot, AActor *thing,
 		return ret;  // out of range
 
 	// When called from the action function, ignore the sight check.
-	if (fromaction || P_CheckSight(thing, bombspot, SF_IGNOREVISIBILITY | SF_IGNOREWATERBOUNDARY))
+	if (fromaction || RadiusAttackSight(bombspot, thing))
 	{
 		dist = clamp<double>(dist - fulldamagedistance, 0, dist);
 		int damage = Scale(bombdamage, bombdistance - int(dist), bombdistance);
@@ -5916,7 +5966,7 @@ int P_RadiusAttack(AActor *bombspot, AActor *bombsource, int bombdamage, int bom
 			double points = GetRadiusDamage(false, bombspot, thing, bombdamage, bombdistance, fulldamagedistance, bombsource == thing);
 			double check = int(points) * bombdamage;
 			// points and bombdamage should be the same sign (the double cast of 'points' is needed to prevent overflows and incorrect values slipping through.)
-			if ((check > 0 || (check == 0 && bombspot->flags7 & MF7_FORCEZERORADIUSDMG)) && P_CheckSight(thing, bombspot, SF_IGNOREVISIBILITY | SF_IGNOREWATERBOUNDARY))
+			if ((check > 0 || (check == 0 && bombspot->flags7 & MF7_FORCEZERORADIUSDMG)) && RadiusAttackSight(bombspot, thing))
 			{ // OK to damage; target is in direct path
 				double vz;
 				double thrust;
@@ -6597,6 +6647,91 @@ void PIT_CeilingRaise(AActor *thing, FChangePosition *cpos)
 	}
 }
 
+//=============================================================================
+//
+// P_ChangeSector statistics, for the tic that was last run
+//
+//=============================================================================
+
+static cycle_t ChangeSectorCycles;
+static int ChangeSectorCalls, ChangeSectorChecked, ChangeSectorSkipped;
+static int ChangeSectorTime = -1;
+static double LastChangeSectorMS;
+static int LastChangeSectorCalls, LastChangeSectorChecked, LastChangeSectorSkipped;
+
+static void ChangeSectorStatTic(int maptime)
+{
+	if (maptime != ChangeSectorTime)
+	{
+		LastChangeSectorMS = ChangeSectorCycles.TimeMS();
+		LastChangeSectorCalls = ChangeSectorCalls;
+		LastChangeSectorChecked = ChangeSectorChecked;
+		LastChangeSectorSkipped = ChangeSectorSkipped;
+		ChangeSectorCycles.Reset();
+		ChangeSectorCalls = ChangeSectorChecked = ChangeSectorSkipped = 0;
+		ChangeSectorTime = maptime;
+	}
+}
+
+ADD_STAT(changesector)
+{
+	FString out;
+	out.Format("Sector changes = %d, %04.2f ms (%04.3f ms per sector) - %d things checked, %d skipped",
+		LastChangeSectorCalls, LastChangeSectorMS, LastChangeSectorCalls > 0 ? LastChangeSectorMS / LastChangeSectorCalls : 0.,
+		LastChangeSectorChecked, LastChangeSectorSkipped);
+	return out;
+}
+
+//=============================================================================
+//
+// FChangeSectorFilter
+//
+// Most things touching a moving sector are resting on another sector's
+// floor or are just overlapping its edge. If the moving plane stays
+// strictly between what a thing already has for floorz and dropoffz
+// (or above its ceilingz) it cannot change any of them, so the costly
+// position check can be skipped. This is only attempted for simple
+// cases: flat planes without 3D floors, portals or height transfers.
+//
+//=============================================================================
+
+struct FChangeSectorFilter
+{
+	int plane = -1;		// -1: check everything
+	double lo, hi;		// range the plane's height was in during the move
+
+	FChangeSectorFilter(sector_t *sector, int floorOrCeil, double moveamt)
+	{
+		if (floorOrCeil != sector_t::floor && floorOrCeil != sector_t::ceiling) return;
+		if (sector->heightsec != nullptr || sector->e->FakeFloor.Sectors.Size() > 0) return;
+		if (sector->e->XFloor.ffloors.Size() > 0 || sector->e->XFloor.attached.Size() > 0) return;
+		if (sector->PortalIsLinked(floorOrCeil)) return;
+
+		auto &p = floorOrCeil == sector_t::floor ? sector->floorplane : sector->ceilingplane;
+		if (p.isSlope()) return;
+
+		double h = p.ZatPoint(0., 0.);
+		lo = h - moveamt;
+		hi = h + moveamt;
+		plane = floorOrCeil;
+	}
+
+	bool Unaffected(AActor *thing) const
+	{
+		if (plane < 0 || thing->player != nullptr) return false;
+		if ((thing->flags2 & MF2_PASSMOBJ) || (thing->flags4 & MF4_ACTLIKEBRIDGE)) return false;
+
+		if (plane == sector_t::floor)
+		{
+			return thing->floorz > hi && thing->dropoffz < lo;
+		}
+		else
+		{
+			return thing->ceilingz < lo && thing->Top() <= thing->ceilingz && thing->Z() >= thing->floorz;
+		}
+	}
+};
+
 //=============================================================================
 //
 // P_ChangeSector	[RH] Was P_CheckSector in BOOM
@@ -6621,6 +6756,13 @@ bool P_ChangeSector(sector_t *sector, int crunch, double amt, int floorOrCeil, b
 	cpos.sector = sector;
 	cpos.instant = instant;
 
+	ChangeSectorStatTic(sector->Level->maptime);
+	ChangeSectorCalls++;
+	ChangeSectorCycles.Clock();
+
+	// The moved plane may now block (or no longer block) precalculated sight lines.
+	sector->Level->SightPrecalc.Invalidate();
+
 	// Also process all sectors that have 3D floors transferred from the
 	// changed sector.
 	if (sector->e->XFloor.attached.Size() && floorOrCeil != 2)
@@ -6695,6 +6837,7 @@ bool P_ChangeSector(sector_t *sector, int crunch, double amt, int floorOrCeil, b
 	default:
 		// invalid
 		assert(floorOrCeil > 0 && floorOrCeil < 2);
+		ChangeSectorCycles.Unclock();
 		return false;
 	}
 
@@ -6705,29 +6848,47 @@ bool P_ChangeSector(sector_t *sector, int crunch, double amt, int floorOrCeil, b
 	// Things can arbitrarily be inserted and removed and it won't mess up.
 	//
 	// killough 4/7/98: simplified to avoid using complicated counter
+	//
+	// Restarting is only necessary if the list actually changed. Otherwise
+	// everything before the current node has been visited already and the
+	// scan can simply continue, which visits things in the same order.
+
+	FChangeSectorFilter filter(sector, floorOrCeil, cpos.moveamt);
 
 	// Mark all things invalid
 
 	for (n = sector->touching_thinglist; n; n = n->m_snext)
 		n->visited = false;
 
-	do
+	n = sector->touching_thinglist;
+	while (n)
 	{
-		for (n = sector->touching_thinglist; n; n = n->m_snext)	// go through list
+		if (!n->visited)								// unprocessed thing found
 		{
-			if (!n->visited)								// unprocessed thing found
+			n->visited = true; 							// mark thing as processed
+			if (!(n->m_thing->flags & MF_NOBLOCKMAP) ||	//jff 4/7/98 don't do these
+				(n->m_thing->flags5 & MF5_MOVEWITHSECTOR))
 			{
-				n->visited = true; 							// mark thing as processed
-				if (!(n->m_thing->flags & MF_NOBLOCKMAP) ||	//jff 4/7/98 don't do these
-					(n->m_thing->flags5 & MF5_MOVEWITHSECTOR))
+				if (filter.Unaffected(n->m_thing))
+				{
+					ChangeSectorSkipped++;
+				}
+				else
 				{
+					unsigned changes = thinglist_changes;
+					ChangeSectorChecked++;
 					iterator(n->m_thing, &cpos);		 			// process it
 					if (iterator2 != NULL) iterator2(n->m_thing, &cpos);
+					if (changes != thinglist_changes)
+					{
+						n = sector->touching_thinglist;		// start over
+						continue;
+					}
 				}
-				break;										// exit and start over
 			}
 		}
-	} while (n);	// repeat from scratch until all things left are marked valid
+		n = n->m_snext;
+	}
 
 	if (floorOrCeil != 2) sector->CheckPortalPlane(floorOrCeil);	// check for portal obstructions after everything is done.
 
@@ -6762,6 +6923,7 @@ bool P_ChangeSector(sector_t *sector, int crunch, double amt, int floorOrCeil, b
 
 	}
 
+	ChangeSectorCycles.Unclock();
 	return cpos.nofit;
 }
 
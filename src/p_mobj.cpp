@@ -382,6 +382,7 @@ void AActor::PostSerialize()
 	LinkToWorld(nullptr, false, Sector);
 
 	AddToHash();
+	AddToClassIndex();
 	if (player)
 	{
 		if (Level->PlayerInGame(player) &&
@@ -2916,16 +2917,7 @@ void AActor::AddToHash ()
 	}
 	else
 	{
-		int hash = TIDHASH (tid);
-		auto &slot = Level->TIDHash[hash];
-
-		inext = slot;
-		iprev = &slot;
-		slot = this;
-		if (inext)
-		{
-			inext->iprev = &inext;
-		}
+		Level->TIDHash.Link(this);
 	}
 }
 
@@ -2938,15 +2930,127 @@ void AActor::RemoveFromHash ()
 {
 	if (tid != 0 && iprev)
 	{
-		*iprev = inext;
-		if (inext)
+		Level->TIDHash.Unlink(this);
+	}
+	tid = 0;
+}
+
+//==========================================================================
+//
+// FTIDHash :: Link
+//
+//==========================================================================
+
+void FTIDHash::Link(AActor *actor)
+{
+	if (++Count > Buckets.Size() * MAXLOAD)
+	{
+		Grow();
+	}
+
+	auto &slot = Bucket(actor->tid);
+
+	actor->inext = slot;
+	actor->iprev = &slot;
+	slot = actor;
+	if (actor->inext)
+	{
+		actor->inext->iprev = &actor->inext;
+	}
+}
+
+//==========================================================================
+//
+// FTIDHash :: Unlink
+//
+//==========================================================================
+
+void FTIDHash::Unlink(AActor *actor)
+{
+	*actor->iprev = actor->inext;
+	if (actor->inext)
+	{
+		actor->inext->iprev = actor->iprev;
+	}
+	actor->iprev = NULL;
+	actor->inext = NULL;
+	Count--;
+}
+
+//==========================================================================
+//
+// FTIDHash :: Grow
+//
+// Doubles the bucket count. Each new bucket only receives actors from
+// one old bucket and they get appended in their old order, so an
+// FActorIterator that is in the middle of a chain will neither skip
+// nor repeat any actor.
+//
+//==========================================================================
+
+void FTIDHash::Grow()
+{
+	TArray<AActor *> old = std::move(Buckets);
+	TArray<AActor **> tails;
+
+	Buckets.Resize(old.Size() * 2);
+	memset(Buckets.Data(), 0, Buckets.Size() * sizeof(AActor*));
+	Shift--;
+
+	tails.Resize(Buckets.Size());
+	for (unsigned i = 0; i < Buckets.Size(); i++)
+	{
+		tails[i] = &Buckets[i];
+	}
+
+	for (auto probe : old)
+	{
+		while (probe != nullptr)
 		{
-			inext->iprev = iprev;
+			AActor *next = probe->inext;
+			auto &tail = tails[&Bucket(probe->tid) - Buckets.Data()];
+
+			probe->iprev = tail;
+			probe->inext = nullptr;
+			*tail = probe;
+			tail = &probe->inext;
+			probe = next;
 		}
-		iprev = NULL;
-		inext = NULL;
 	}
-	tid = 0;
+}
+
+//==========================================================================
+//
+// AActor :: AddToClassIndex
+//
+// Keeps a list of all live actors per class so that looking for all
+// actors of a given class does not have to go through every thinker.
+//
+//==========================================================================
+
+void AActor::AddToClassIndex()
+{
+	auto &list = Level->ActorsByClass[GetClass()];
+	if (ClassIndex < list.Size() && list[ClassIndex] == this)
+	{
+		return;
+	}
+	ClassIndex = list.Push(this);
+}
+
+void AActor::RemoveFromClassIndex()
+{
+	if (Level == nullptr) return;
+	auto list = Level->ActorsByClass.CheckKey(GetClass());
+	if (list == nullptr || ClassIndex >= list->Size() || (*list)[ClassIndex] != this)
+	{
+		return;
+	}
+	AActor *last = list->Last();
+	(*list)[ClassIndex] = last;
+	last->ClassIndex = ClassIndex;
+	list->Pop();
+	ClassIndex = 0;
 }
 
 void AActor::SetTID (int newTID)
@@ -2977,7 +3081,7 @@ void AActor::SetTID (int newTID)
 
 bool FLevelLocals::IsTIDUsed(int tid)
 {
-	AActor *probe = TIDHash[tid & 127];
+	AActor *probe = TIDHash.Bucket(tid);
 	while (probe != NULL)
 	{
 		if (probe->tid == tid)
@@ -4379,6 +4483,7 @@ void ConstructActor(AActor *actor, const DVector3 &pos, bool SpawningMapThing)
 	auto Level = actor->Level;
 	actor->SpawnTime = Level->totaltime;
 	actor->SpawnOrder = Level->spawnindex++;
+	actor->AddToClassIndex();
 
 	// Set default dialogue
 	actor->ConversationRoot = Level->GetConversation(actor->GetClass()->TypeName);
@@ -4833,6 +4938,7 @@ void AActor::OnDestroy ()
 
 	// [RH] Unlink from tid chain
 	RemoveFromHash ();
+	RemoveFromClassIndex ();
 
 	// unlink from sector and block lists
 	UnlinkFromWorld (nullptr);
@@ -60,8 +60,12 @@
 #include "r_sky.h"
 #include "version.h"
 #include "fragglescript/t_script.h"
+#include "c_dispatch.h"
+#include "g_game.h"
+#include "stats.h"
 
 EXTERN_CVAR(Bool, save_formatted)
+EXTERN_CVAR(Bool, save_binary)
 
 //==========================================================================
 //
@@ -1036,10 +1040,12 @@ void FLevelLocals::Serialize(FSerializer &arc, bool hubload)
 //==========================================================================
 //
 // Archives the current level
+// Savegames may skip the compression and leave it to the thread
+// writing the file.
 //
 //==========================================================================
 
-void FLevelLocals::SnapshotLevel()
+void FLevelLocals::SnapshotLevel(bool compress)
 {
 	info->Snapshot.Clean();
 
@@ -1047,11 +1053,11 @@ void FLevelLocals::SnapshotLevel()
 	{
 		FSerializer arc(this);
 
-		if (arc.OpenWriter(save_formatted))
+		if (save_binary ? arc.OpenBinaryWriter() : arc.OpenWriter(save_formatted))
 		{
 			SaveVersion = SAVEVER;
 			Serialize(arc, false);
-			info->Snapshot = arc.GetCompressedOutput();
+			info->Snapshot = arc.GetCompressedOutput(compress);
 		}
 	}
 }
@@ -1116,3 +1122,56 @@ void FLevelLocals::UnSnapshotLevel(bool hubLoad)
 	}
 }
 
+
+//==========================================================================
+//
+// Compares the speed of the JSON and binary savegame formats
+// by repeatedly snapshotting the current level.
+// Reading only covers decompression and building the document,
+// restoring the level from it is the same for both formats.
+//
+//==========================================================================
+
+CCMD(benchsave)
+{
+	if (gamestate != GS_LEVEL)
+	{
+		Printf("You can only benchmark saving inside a level.\n");
+		return;
+	}
+	int count = argv.argc() > 1 ? clamp(atoi(argv[1]), 1, 1000) : 10;
+	static const char *const formats[] = { "JSON", "binary" };
+
+	for (int binary = 0; binary < 2; binary++)
+	{
+		cycle_t writetime, readtime;
+		FCompressedBuffer buff = { 0, 0, METHOD_STORED, 0, 0, nullptr };
+
+		writetime.Reset();
+		readtime.Reset();
+		for (int i = 0; i < count; i++)
+		{
+			buff.Clean();
+			{
+				FSerializer arc(primaryLevel);
+				writetime.Clock();
+				if (binary) arc.OpenBinaryWriter();
+				else arc.OpenWriter(false);
+				SaveVersion = SAVEVER;
+				primaryLevel->Serialize(arc, false);
+				buff = arc.GetCompressedOutput();
+				writetime.Unclock();
+			}
+			{
+				FSerializer arc(primaryLevel);
+				readtime.Clock();
+				arc.OpenReader(&buff);
+				arc.Close();
+				readtime.Unclock();
+			}
+		}
+		Printf("%s: write %2.3f ms, read %2.3f ms, %u bytes, %u compressed\n", formats[binary],
+			writetime.TimeMS() / count, readtime.TimeMS() / count, buff.mSize, buff.mCompressedSize);
+		buff.Clean();
+	}
+}
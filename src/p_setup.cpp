@@ -297,6 +297,11 @@ void FLevelLocals::ClearLevelData()
 	ACSThinker = nullptr;
 	FraggleScriptThinker = nullptr;
 	CorpseQueue.Clear();
+	SightPrecalc.Clear();
+	RadiusSightCache.Clear();
+	NoiseGraph.Clear();
+	NoiseGraphStart.Clear();
+	NoiseGraphPortals.Clear();
 	canvasTextureInfo.EmptyList();
 	sections.Clear();
 	segs.Clear();
@@ -42,6 +42,12 @@
 #include "r_data/models/models_ue1.h"
 #include "r_data/models/models_obj.h"
 #include "i_time.h"
+#include "m_misc.h"
+#include "md5.h"
+#include "files.h"
+#include <zlib.h>
+#include <atomic>
+#include <memory>
 
 #ifdef _MSC_VER
 #pragma warning(disable:4244) // warning C4244: conversion from 'double' to 'float', possible loss of data
@@ -51,6 +57,7 @@
 CVAR(Bool, gl_interpolate_model_frames, true, CVAR_ARCHIVE)
 CVAR(Float, gl_weaponOfsY, 0.0f, CVAR_ARCHIVE)
 CVAR(Float, gl_weaponOfsZ, 0.0f, CVAR_ARCHIVE)
+CVAR(Bool, gl_model_cache, true, CVAR_ARCHIVE | CVAR_GLOBALCONFIG)
 EXTERN_CVAR(Bool, r_drawvoxels)
 
 extern TDeletingArray<FVoxel *> Voxels;
@@ -322,6 +329,111 @@ void FModel::DestroyVertexBuffer()
 	}
 }
 
+//===========================================================================
+//
+// Model geometry cache
+//
+// Stores vertex and index data exactly as it gets uploaded so that
+// neither the model file needs to be unpacked nor voxel meshes rebuilt
+// when a vertex buffer is created again, be it after a level change,
+// a renderer switch or in a later session.
+//
+//===========================================================================
+
+static const char ModelCacheMagic[4] = { 'M', 'D', 'C', '1' };
+
+bool FModel::LoadCachedMesh(int lumpnum, TArray<FModelVertex> &vertices, TArray<unsigned int> &indices)
+{
+	if (!gl_model_cache || lumpnum < 0) return false;
+
+	if (mCacheName.IsEmpty())
+	{
+		static const FString dir = []()
+		{
+			FString path = M_GetCachePath(true);
+			path << "/modelcache/";
+			CreatePath(path);
+			return path;
+		}();
+
+		FMemLump lumpdata = Wads.ReadLump(lumpnum);
+		uint32_t vertexsize = sizeof(FModelVertex);
+		uint8_t digest[16];
+		MD5Context md5;
+		md5.Update((const uint8_t *)&vertexsize, sizeof(vertexsize));
+		md5.Update((const uint8_t *)lumpdata.GetMem(), Wads.LumpLength(lumpnum));
+		md5.Final(digest);
+
+		mCacheName = dir;
+		for (int i = 0; i < 16; i++) mCacheName.AppendFormat("%02x", digest[i]);
+		mCacheName << ".mdc";
+	}
+
+	FileReader fr;
+	if (!fr.OpenFile(mCacheName)) return false;
+
+	char magic[4];
+	uint32_t header[3];	// vertex count, index count, compressed size
+	if (fr.Read(magic, 4) != 4 || memcmp(magic, ModelCacheMagic, 4) != 0) return false;
+	if (fr.Read(header, sizeof(header)) != sizeof(header)) return false;
+
+	uLongf size = uLongf(header[0]) * sizeof(FModelVertex) + uLongf(header[1]) * sizeof(unsigned int);
+	if (header[0] == 0 || header[2] > compressBound(size)) return false;
+
+	TArray<uint8_t> compressed(header[2], true);
+	TArray<uint8_t> data(size, true);
+	if (fr.Read(compressed.Data(), header[2]) != header[2]) return false;
+	uLongf outsize = size;
+	if (uncompress(data.Data(), &outsize, compressed.Data(), header[2]) != Z_OK || outsize != size) return false;
+
+	vertices.Resize(header[0]);
+	indices.Resize(header[1]);
+	memcpy(vertices.Data(), data.Data(), header[0] * sizeof(FModelVertex));
+	if (header[1] > 0) memcpy(indices.Data(), data.Data() + header[0] * sizeof(FModelVertex), header[1] * sizeof(unsigned int));
+	return true;
+}
+
+void FModel::SaveCachedMesh(const TArray<FModelVertex> &vertices, const TArray<unsigned int> &indices)
+{
+	if (mCacheName.IsEmpty() || vertices.Size() == 0) return;
+
+	TArray<uint8_t> data(vertices.Size() * sizeof(FModelVertex) + indices.Size() * sizeof(unsigned int), true);
+	memcpy(data.Data(), vertices.Data(), vertices.Size() * sizeof(FModelVertex));
+	if (indices.Size() > 0) memcpy(data.Data() + vertices.Size() * sizeof(FModelVertex), indices.Data(), indices.Size() * sizeof(unsigned int));
+
+	uLongf size = compressBound(data.Size());
+	TArray<uint8_t> compressed(size, true);
+	if (compress2(compressed.Data(), &size, data.Data(), data.Size(), Z_BEST_SPEED) != Z_OK) return;
+
+	// Write to a unique temporary file first so that a concurrent reader never sees a partial entry.
+	static std::atomic<int> tempcount;
+	FString tempname = FStringf("%s.%d.tmp", mCacheName.GetChars(), tempcount++);
+	std::unique_ptr<FileWriter> fw(FileWriter::Open(tempname));
+	if (!fw) return;
+
+	uint32_t header[3] = { vertices.Size(), indices.Size(), (uint32_t)size };
+	bool ok = fw->Write(ModelCacheMagic, 4) == 4 && fw->Write(header, sizeof(header)) == sizeof(header) && fw->Write(compressed.Data(), size) == size;
+	fw.reset();
+	if (!ok || rename(tempname, mCacheName) != 0) remove(tempname);
+}
+
+void FModel::UploadMesh(FModelRenderer *renderer, const TArray<FModelVertex> &vertices, const TArray<unsigned int> &indices, bool needindex, bool singleframe)
+{
+	auto vbuf = renderer->CreateVertexBuffer(needindex, singleframe);
+	SetVertexBuffer(renderer, vbuf);
+
+	FModelVertex *vertptr = vbuf->LockVertexBuffer(vertices.Size());
+	memcpy(vertptr, vertices.Data(), sizeof(FModelVertex) * vertices.Size());
+	vbuf->UnlockVertexBuffer();
+
+	if (needindex)
+	{
+		unsigned int *indxptr = vbuf->LockIndexBuffer(indices.Size());
+		memcpy(indxptr, indices.Data(), sizeof(unsigned int) * indices.Size());
+		vbuf->UnlockIndexBuffer();
+	}
+}
+
 static TArray<FSpriteModelFrame> SpriteModelFrames;
 static TArray<int> SpriteModelHash;
 //TArray<FStateModelFrame> StateModelFrames;
@@ -416,9 +528,11 @@ static unsigned FindModel(const char * path, const char * modelfile)
 		if (!Models[i]->mFileName.CompareNoCase(fullname)) return i;
 	}
 
+	// UE1 and OBJ models are identified by name and only read their data when first used,
+	// so the lump only needs to be loaded here for the formats that are detected by their header.
 	int len = Wads.LumpLength(lump);
-	FMemLump lumpd = Wads.ReadLump(lump);
-	char * buffer = (char*)lumpd.GetMem();
+	FMemLump lumpd;
+	const char * buffer = nullptr;
 
 	if ( (size_t)fullname.LastIndexOf("_d.3d") == fullname.Len()-5 )
 	{
@@ -442,17 +556,23 @@ static unsigned FindModel(const char * path, const char * modelfile)
 	{
 		model = new FOBJModel;
 	}
-	else if (!memcmp(buffer, "DMDM", 4))
-	{
-		model = new FDMDModel;
-	}
-	else if (!memcmp(buffer, "IDP2", 4))
-	{
-		model = new FMD2Model;
-	}
-	else if (!memcmp(buffer, "IDP3", 4))
+	else if (len >= 4)
 	{
-		model = new FMD3Model;
+		lumpd = Wads.ReadLump(lump);
+		buffer = (const char*)lumpd.GetMem();
+
+		if (!memcmp(buffer, "DMDM", 4))
+		{
+			model = new FDMDModel;
+		}
+		else if (!memcmp(buffer, "IDP2", 4))
+		{
+			model = new FMD2Model;
+		}
+		else if (!memcmp(buffer, "IDP3", 4))
+		{
+			model = new FMD3Model;
+		}
 	}
 
 	if (model != nullptr)
@@ -152,8 +152,15 @@ public:
 
 	FString mFileName;
 
+protected:
+	// Preprocessed vertex data is kept in a disk cache keyed by the source lump's hash.
+	bool LoadCachedMesh(int lumpnum, TArray<FModelVertex> &vertices, TArray<unsigned int> &indices);
+	void SaveCachedMesh(const TArray<FModelVertex> &vertices, const TArray<unsigned int> &indices);
+	void UploadMesh(FModelRenderer *renderer, const TArray<FModelVertex> &vertices, const TArray<unsigned int> &indices, bool needindex, bool singleframe);
+
 private:
 	IModelVertexBuffer *mVBuf[NumModelRendererTypes];
+	FString mCacheName;
 };
 
 class FDMDModel : public FModel
@@ -281,42 +281,55 @@ void FDMDModel::BuildVertexBuffer(FModelRenderer *renderer)
 {
 	if (!GetVertexBuffer(renderer))
 	{
-		LoadGeometry();
+		TArray<FModelVertex> vertices;
+		TArray<unsigned int> indices;
 
-		int VertexBufferSize = info.numFrames * lodInfo[0].numTriangles * 3;
-		unsigned int vindex = 0;
-
-		auto vbuf = renderer->CreateVertexBuffer(false, info.numFrames == 1);
-		SetVertexBuffer(renderer, vbuf);
-
-		FModelVertex *vertptr = vbuf->LockVertexBuffer(VertexBufferSize);
-
-		for (int i = 0; i < info.numFrames; i++)
+		if (info.numFrames > 0 && LoadCachedMesh(mLumpNum, vertices, indices) && vertices.Size() % (info.numFrames * 3) == 0)
+		{
+			// DMD only knows the triangle count after loading the geometry.
+			lodInfo[0].numTriangles = vertices.Size() / (info.numFrames * 3);
+		}
+		else
 		{
-			DMDModelVertex *vert = framevtx[i].vertices;
-			DMDModelVertex *norm = framevtx[i].normals;
+			LoadGeometry();
+			indices.Clear();
 
-			frames[i].vindex = vindex;
+			int VertexBufferSize = info.numFrames * lodInfo[0].numTriangles * 3;
+			unsigned int vindex = 0;
 
-			FTriangle *tri = lods[0].triangles;
+			vertices.Resize(VertexBufferSize);
 
-			for (int i = 0; i < lodInfo[0].numTriangles; i++)
+			for (int i = 0; i < info.numFrames; i++)
 			{
-				for (int j = 0; j < 3; j++)
+				DMDModelVertex *vert = framevtx[i].vertices;
+				DMDModelVertex *norm = framevtx[i].normals;
+
+				FTriangle *tri = lods[0].triangles;
+
+				for (int i = 0; i < lodInfo[0].numTriangles; i++)
 				{
+					for (int j = 0; j < 3; j++)
+					{
 
-					int ti = tri->textureIndices[j];
-					int vi = tri->vertexIndices[j];
+						int ti = tri->textureIndices[j];
+						int vi = tri->vertexIndices[j];
 
-					FModelVertex *bvert = &vertptr[vindex++];
-					bvert->Set(vert[vi].xyz[0], vert[vi].xyz[1], vert[vi].xyz[2], (float)texCoords[ti].s / info.skinWidth, (float)texCoords[ti].t / info.skinHeight);
-					bvert->SetNormal(norm[vi].xyz[0], norm[vi].xyz[1], norm[vi].xyz[2]);
+						FModelVertex *bvert = &vertices[vindex++];
+						bvert->Set(vert[vi].xyz[0], vert[vi].xyz[1], vert[vi].xyz[2], (float)texCoords[ti].s / info.skinWidth, (float)texCoords[ti].t / info.skinHeight);
+						bvert->SetNormal(norm[vi].xyz[0], norm[vi].xyz[1], norm[vi].xyz[2]);
+					}
+					tri++;
 				}
-				tri++;
 			}
+			UnloadGeometry();
+			SaveCachedMesh(vertices, indices);
+		}
+
+		for (int i = 0; i < info.numFrames; i++)
+		{
+			frames[i].vindex = i * lodInfo[0].numTriangles * 3;
 		}
-		vbuf->UnlockVertexBuffer();
-		UnloadGeometry();
+		UploadMesh(renderer, vertices, indices, false, info.numFrames == 1);
 	}
 }
 
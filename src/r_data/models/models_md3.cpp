@@ -240,56 +240,57 @@ void FMD3Model::BuildVertexBuffer(FModelRenderer *renderer)
 {
 	if (!GetVertexBuffer(renderer))
 	{
-		LoadGeometry();
-
 		unsigned int vbufsize = 0;
 		unsigned int ibufsize = 0;
 
 		for (unsigned i = 0; i < Surfaces.Size(); i++)
 		{
 			MD3Surface * surf = &Surfaces[i];
+			surf->vindex = vbufsize;
+			surf->iindex = ibufsize;
 			vbufsize += Frames.Size() * surf->numVertices;
 			ibufsize += 3 * surf->numTriangles;
 		}
 
-		auto vbuf = renderer->CreateVertexBuffer(true, Frames.Size() == 1);
-		SetVertexBuffer(renderer, vbuf);
-
-		FModelVertex *vertptr = vbuf->LockVertexBuffer(vbufsize);
-		unsigned int *indxptr = vbuf->LockIndexBuffer(ibufsize);
+		TArray<FModelVertex> vertices;
+		TArray<unsigned int> indices;
 
-		assert(vertptr != nullptr && indxptr != nullptr);
+		if (!LoadCachedMesh(mLumpNum, vertices, indices) || vertices.Size() != vbufsize || indices.Size() != ibufsize)
+		{
+			LoadGeometry();
 
-		unsigned int vindex = 0, iindex = 0;
+			vertices.Resize(vbufsize);
+			indices.Resize(ibufsize);
 
-		for (unsigned i = 0; i < Surfaces.Size(); i++)
-		{
-			MD3Surface * surf = &Surfaces[i];
+			unsigned int vindex = 0, iindex = 0;
 
-			surf->vindex = vindex;
-			surf->iindex = iindex;
-			for (unsigned j = 0; j < Frames.Size() * surf->numVertices; j++)
+			for (unsigned i = 0; i < Surfaces.Size(); i++)
 			{
-				MD3Vertex* vert = &surf->Vertices[j];
+				MD3Surface * surf = &Surfaces[i];
 
-				FModelVertex *bvert = &vertptr[vindex++];
+				for (unsigned j = 0; j < Frames.Size() * surf->numVertices; j++)
+				{
+					MD3Vertex* vert = &surf->Vertices[j];
 
-				int tc = j % surf->numVertices;
-				bvert->Set(vert->x, vert->z, vert->y, surf->Texcoords[tc].s, surf->Texcoords[tc].t);
-				bvert->SetNormal(vert->nx, vert->nz, vert->ny);
-			}
+					FModelVertex *bvert = &vertices[vindex++];
 
-			for (unsigned k = 0; k < surf->numTriangles; k++)
-			{
-				for (int l = 0; l < 3; l++)
+					int tc = j % surf->numVertices;
+					bvert->Set(vert->x, vert->z, vert->y, surf->Texcoords[tc].s, surf->Texcoords[tc].t);
+					bvert->SetNormal(vert->nx, vert->nz, vert->ny);
+				}
+
+				for (unsigned k = 0; k < surf->numTriangles; k++)
 				{
-					indxptr[iindex++] = surf->Tris[k].VertIndex[l];
+					for (int l = 0; l < 3; l++)
+					{
+						indices[iindex++] = surf->Tris[k].VertIndex[l];
+					}
 				}
+				surf->UnloadGeometry();
 			}
-			surf->UnloadGeometry();
+			SaveCachedMesh(vertices, indices);
 		}
-		vbuf->UnlockVertexBuffer();
-		vbuf->UnlockIndexBuffer();
+		UploadMesh(renderer, vertices, indices, true, Frames.Size() == 1);
 	}
 }
 
@@ -25,13 +25,59 @@
 /**
  * Load an OBJ model
  *
+ * The model is only registered here. Parsing the text is deferred until the
+ * model is used for the first time, so models that are defined but never
+ * shown cost nothing at startup.
+ *
+ * @param fn The path to the model file
+ * @param lumpnum The lump index in the wad collection
+ * @param buffer Unused, the lump is read again once it gets parsed
+ * @param length Unused
+ * @return Always true
+ */
+bool FOBJModel::Load(const char* fn, int lumpnum, const char* buffer, int length)
+{
+	mPath = fn;
+	mLumpNum = lumpnum;
+	return true;
+}
+
+/**
+ * Parse the model if that hasn't been done yet
+ *
+ * A model that fails to parse is left without any surfaces and draws nothing.
+ */
+void FOBJModel::ParseIfNeeded()
+{
+	if (mLumpNum < 0)
+	{
+		return;
+	}
+	int lumpnum = mLumpNum;
+	mLumpNum = -1;
+
+	FMemLump lumpd = Wads.ReadLump(lumpnum);
+	if (!Parse(mPath, lumpnum, (const char*)lumpd.GetMem(), Wads.LumpLength(lumpnum)))
+	{
+		Printf("LoadModel: Unable to parse '%s'\n", mFileName.GetChars());
+		verts.Clear();
+		norms.Clear();
+		uvs.Clear();
+		faces.Clear();
+		surfaces.Clear();
+	}
+}
+
+/**
+ * Parse an OBJ model
+ *
  * @param fn The path to the model file
  * @param lumpnum The lump index in the wad collection
  * @param buffer The contents of the model file
  * @param length The size of the model file
  * @return Whether or not the model was parsed successfully
  */
-bool FOBJModel::Load(const char* fn, int lumpnum, const char* buffer, int length)
+bool FOBJModel::Parse(const char* fn, int lumpnum, const char* buffer, int length)
 {
 	FString objName = Wads.GetLumpFullPath(lumpnum);
 	FString objBuf(buffer, length);
@@ -358,6 +404,7 @@ void FOBJModel::BuildVertexBuffer(FModelRenderer *renderer)
 	{
 		return;
 	}
+	ParseIfNeeded();
 
 	unsigned int vbufsize = 0;
 
@@ -663,6 +710,7 @@ void FOBJModel::RenderFrame(FModelRenderer *renderer, FTexture * skin, int frame
  */
 void FOBJModel::AddSkins(uint8_t* hitlist)
 {
+	ParseIfNeeded();
 	for (size_t i = 0; i < surfaces.Size(); i++)
 	{
 		if (i < MD3_MAX_SURFACES && curSpriteMDLFrame->surfaceskinIDs[curMDLIndex][i].isValid())
@@ -32,6 +32,8 @@ private:
 	const char *newSideSep = "$"; // OBJ side separator is /, which is parsed as a line comment by FScanner if two of them are next to each other.
 	bool hasMissingNormals;
 	bool hasSmoothGroups;
+	int mLumpNum; // Lump that still needs to be parsed, -1 once that happened
+	FString mPath;
 
 	enum class FaceElement
 	{
@@ -80,6 +82,8 @@ private:
 	FScanner sc;
 	TArray<OBJTriRef>* vertFaces;
 
+	bool Parse(const char* fn, int lumpnum, const char* buffer, int length);
+	void ParseIfNeeded();
 	int ResolveIndex(int origIndex, FaceElement el);
 	template<typename T, size_t L> void ParseVector(TArray<T> &array);
 	bool ParseFaceSide(const FString &side, OBJFace &face, int sidx);
@@ -92,7 +96,7 @@ private:
 	FVector3 CalculateNormalFlat(OBJTriRef otr);
 	FVector3 CalculateNormalSmooth(unsigned int vidx, unsigned int smoothGroup);
 public:
-	FOBJModel(): hasMissingNormals(false), hasSmoothGroups(false), vertFaces(nullptr) {}
+	FOBJModel(): hasMissingNormals(false), hasSmoothGroups(false), mLumpNum(-1), vertFaces(nullptr) {}
 	~FOBJModel();
 	bool Load(const char* fn, int lumpnum, const char* buffer, int length) override;
 	int FindFrame(const char* name) override;
@@ -135,20 +135,26 @@ void FUE1Model::LoadGeometry()
 		polys.Push(Poly);
 	}
 	// compute normals for vertex arrays
-	// iterates through all polys and compute the average of all facet normals
-	// from those who use this vertex. not pretty, but does the job
+	// each vertex gets the average of the facet normals of all polys that use it.
+	// the sums are accumulated in a single pass over the poly list per frame,
+	// each poly counting once per distinct vertex, in poly order.
+	TArray<FVector3> nsum(numVerts, true);
 	for ( int i=0; i<numFrames; i++ )
 	{
 		for ( int j=0; j<numVerts; j++ )
+			nsum[j] = FVector3(0,0,0);
+		for ( int k=0; k<numPolys; k++ )
 		{
-			FVector3 nsum = FVector3(0,0,0);
-			for ( int k=0; k<numPolys; k++ )
+			const int *V = polys[k].V;
+			for ( int l=0; l<3; l++ )
 			{
-				if ( (polys[k].V[0] != j) && (polys[k].V[1] != j) && (polys[k].V[2] != j) ) continue;
-				nsum += polys[k].Normals[i];
+				if ( (l > 0 && V[l] == V[0]) || (l > 1 && V[l] == V[1]) ) continue;
+				if ( (unsigned)V[l] < (unsigned)numVerts )
+					nsum[V[l]] += polys[k].Normals[i];
 			}
-			verts[j+numVerts*i].Normal = nsum.Unit();
 		}
+		for ( int j=0; j<numVerts; j++ )
+			verts[j+numVerts*i].Normal = nsum[j].Unit();
 	}
 	// populate poly groups (subdivided by texture number and type)
 	// this method minimizes searches in the group list as much as possible
@@ -320,19 +320,12 @@ void FVoxelModel::BuildVertexBuffer(FModelRenderer *renderer)
 {
 	if (!GetVertexBuffer(renderer))
 	{
-		Initialize();
-
-		auto vbuf = renderer->CreateVertexBuffer(true, true);
-		SetVertexBuffer(renderer, vbuf);
-
-		FModelVertex *vertptr = vbuf->LockVertexBuffer(mVertices.Size());
-		unsigned int *indxptr = vbuf->LockIndexBuffer(mIndices.Size());
-
-		memcpy(vertptr, &mVertices[0], sizeof(FModelVertex)* mVertices.Size());
-		memcpy(indxptr, &mIndices[0], sizeof(unsigned int)* mIndices.Size());
-
-		vbuf->UnlockVertexBuffer();
-		vbuf->UnlockIndexBuffer();
+		if (!LoadCachedMesh(mVoxel->LumpNum, mVertices, mIndices))
+		{
+			Initialize();
+			SaveCachedMesh(mVertices, mIndices);
+		}
+		UploadMesh(renderer, mVertices, mIndices, true, true);
 		mNumIndices = mIndices.Size();
 
 		// delete our temporary buffers
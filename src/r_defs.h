@@ -105,6 +105,7 @@ struct vertex_t
 	int numsectors;
 	sector_t ** sectors;
 	float * heightlist;
+	unsigned heightgen;	// incremented each time the height list changes so that cached wall vertices can be validated.
 
 	void set(fixed_t x, fixed_t y)
 	{
@@ -161,6 +162,7 @@ struct vertex_t
 		numheights = numsectors = 0;
 		sectors = NULL;
 		heightlist = NULL;
+		heightgen = 0;
 	}
 
 	~vertex_t()
@@ -85,7 +85,7 @@ DEFINE_ACTION_FUNCTION(DShape2D, PushTriangle)
 
 int F2DDrawer::AddCommand(const RenderCommand *data) 
 {
-	if (mData.Size() > 0 && data->isCompatible(mData.Last()))
+	if (mData.Size() > mMergeBarrier && data->isCompatible(mData.Last()))
 	{
 		// Merge with the last command.
 		mData.Last().mIndexCount += data->mIndexCount;
@@ -675,5 +675,182 @@ void F2DDrawer::Clear()
 	mVertices.Clear();
 	mIndices.Clear();
 	mData.Clear();
+	mMergeBarrier = 0;
 	mIsFirstPass = true;
+}
+
+//==========================================================================
+//
+// Display lists
+//
+// If the list was recorded with the same key it gets replayed and false
+// is returned. Otherwise the caller has to draw its content and call
+// EndDisplayList afterward so that it can be replayed next time.
+// The key must contain everything the drawing depends on.
+//
+//==========================================================================
+
+bool F2DDrawer::BeginDisplayList(FDisplayList &list, std::initializer_list<intptr_t> key)
+{
+	if (list.mValid && list.mKey.Size() == key.size() && std::equal(key.begin(), key.end(), list.mKey.begin()))
+	{
+		int vertbase = mVertices.Reserve(list.mVertices.Size());
+		memcpy(mVertices.Data() + vertbase, list.mVertices.Data(), list.mVertices.Size() * sizeof(TwoDVertex));
+		int indexbase = mIndices.Reserve(list.mIndices.Size());
+		for (unsigned i = 0; i < list.mIndices.Size(); i++)
+		{
+			mIndices[indexbase + i] = list.mIndices[i] + vertbase;
+		}
+		for (auto cmd : list.mData)
+		{
+			cmd.mVertIndex += vertbase;
+			cmd.mIndexIndex += indexbase;
+			AddCommand(&cmd);
+		}
+		return false;
+	}
+	list.mValid = false;
+	list.mKey.Clear();
+	for (auto k : key) list.mKey.Push(k);
+	list.mVertStart = mVertices.Size();
+	list.mIndexStart = mIndices.Size();
+	list.mDataStart = mMergeBarrier = mData.Size();
+	return true;
+}
+
+void F2DDrawer::EndDisplayList(FDisplayList &list)
+{
+	unsigned vertstart = list.mVertStart;
+	unsigned indexstart = list.mIndexStart;
+	list.mVertices.Resize(mVertices.Size() - vertstart);
+	memcpy(list.mVertices.Data(), mVertices.Data() + vertstart, list.mVertices.Size() * sizeof(TwoDVertex));
+	list.mIndices.Resize(mIndices.Size() - indexstart);
+	for (unsigned i = 0; i < list.mIndices.Size(); i++)
+	{
+		list.mIndices[i] = mIndices[indexstart + i] - vertstart;
+	}
+	list.mData.Resize(mData.Size() - list.mDataStart);
+	for (unsigned i = 0; i < list.mData.Size(); i++)
+	{
+		auto &cmd = list.mData[i] = mData[list.mDataStart + i];
+		cmd.mVertIndex -= vertstart;
+		cmd.mIndexIndex -= indexstart;
+	}
+	list.mValid = true;
+}
+
+//==========================================================================
+//
+// MergeCommands
+//
+// AddCommand can only merge a command into the one directly before it.
+// This also merges compatible commands further apart, as long as nothing
+// that gets drawn in between overlaps, so that the drawing order of
+// overlapping things does not change. Since the textures of all the
+// characters of a font share an atlas, this mostly batches up text that
+// is interleaved with other HUD graphics.
+// Only indexed triangles can be moved, the merge only rearranges the
+// index buffer. Lines and points stay where they are.
+//
+//==========================================================================
+
+void F2DDrawer::MergeCommands()
+{
+	const unsigned LookBack = 32;	// Limits the cost for long command lists.
+	unsigned count = mData.Size();
+	if (count < 3) return;
+
+	struct CommandInfo
+	{
+		float x1, y1, x2, y2;
+		int next, last;
+	};
+	TArray<CommandInfo> info(count, true);
+	TArray<unsigned> output;
+	bool merged = false;
+
+	for (unsigned i = 0; i < count; i++)
+	{
+		auto &cmd = mData[i];
+		auto &ci = info[i];
+		ci.x1 = ci.y1 = FLT_MAX;
+		ci.x2 = ci.y2 = -FLT_MAX;
+		ci.next = -1;
+		ci.last = i;
+
+		auto addvertex = [&](const TwoDVertex &v)
+		{
+			ci.x1 = MIN(ci.x1, v.x);
+			ci.y1 = MIN(ci.y1, v.y);
+			ci.x2 = MAX(ci.x2, v.x);
+			ci.y2 = MAX(ci.y2, v.y);
+		};
+		if (cmd.mType == DrawTypeTriangles)
+		{
+			for (int j = 0; j < cmd.mIndexCount; j++) addvertex(mVertices[mIndices[cmd.mIndexIndex + j]]);
+		}
+		else
+		{
+			// Lines and points may cover pixels outside their coordinates.
+			for (int j = 0; j < cmd.mVertCount; j++) addvertex(mVertices[cmd.mVertIndex + j]);
+			ci.x1 -= 1; ci.y1 -= 1;
+			ci.x2 += 1; ci.y2 += 1;
+		}
+
+		int target = -1;
+		if (cmd.mType == DrawTypeTriangles)
+		{
+			for (int k = output.Size() - 1; k >= 0 && output.Size() - k <= LookBack; k--)
+			{
+				auto &ocmd = mData[output[k]];
+				auto &oi = info[output[k]];
+				if (ocmd.mType == DrawTypeTriangles && ocmd.mOutside2D == cmd.mOutside2D && ocmd.isCompatible(cmd))
+				{
+					target = output[k];
+					break;
+				}
+				// Cannot be moved in front of something it overlaps.
+				if (oi.x1 < ci.x2 && ci.x1 < oi.x2 && oi.y1 < ci.y2 && ci.y1 < oi.y2)
+				{
+					break;
+				}
+			}
+		}
+		if (target >= 0)
+		{
+			auto &oi = info[target];
+			info[oi.last].next = i;
+			oi.last = i;
+			oi.x1 = MIN(oi.x1, ci.x1);
+			oi.y1 = MIN(oi.y1, ci.y1);
+			oi.x2 = MAX(oi.x2, ci.x2);
+			oi.y2 = MAX(oi.y2, ci.y2);
+			merged = true;
+		}
+		else
+		{
+			output.Push(i);
+		}
+	}
+	if (!merged) return;
+
+	TArray<int> indices(mIndices.Size());
+	TArray<RenderCommand> data(output.Size());
+	for (auto o : output)
+	{
+		auto &cmd = data[data.Push(mData[o])];
+		if (cmd.mType == DrawTypeTriangles)
+		{
+			cmd.mIndexIndex = indices.Size();
+			for (int s = o; s >= 0; s = info[s].next)
+			{
+				auto &src = mData[s];
+				int start = indices.Reserve(src.mIndexCount);
+				memcpy(indices.Data() + start, mIndices.Data() + src.mIndexIndex, src.mIndexCount * sizeof(int));
+			}
+			cmd.mIndexCount = indices.Size() - cmd.mIndexIndex;
+		}
+	}
+	mIndices.Swap(indices);
+	mData.Swap(data);
 }
\ No newline at end of file
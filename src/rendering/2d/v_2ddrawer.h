@@ -1,6 +1,7 @@
 #ifndef __2DDRAWER_H
 #define __2DDRAWER_H
 
+#include <initializer_list>
 #include "tarray.h"
 #include "textures.h"
 #include "v_palette.h"
@@ -119,9 +120,27 @@ public:
 		}
 	};
 
+	// A recorded sequence of draw commands that can be replayed in later frames
+	// for as long as the inputs that were used to create it stay the same.
+	class FDisplayList
+	{
+		friend class F2DDrawer;
+
+		TArray<TwoDVertex> mVertices;
+		TArray<int> mIndices;
+		TArray<RenderCommand> mData;
+		TArray<intptr_t> mKey;
+		unsigned mVertStart = 0, mIndexStart = 0, mDataStart = 0;
+		bool mValid = false;
+
+	public:
+		void Invalidate() { mValid = false; }
+	};
+
 	TArray<int> mIndices;
 	TArray<TwoDVertex> mVertices;
 	TArray<RenderCommand> mData;
+	unsigned mMergeBarrier = 0;		// AddCommand may not merge into commands before this one.
 	
 	int AddCommand(const RenderCommand *data);
 	void AddIndices(int firstvert, int count, ...);
@@ -146,6 +165,10 @@ public:
 	void AddThickLine(int x1, int y1, int x2, int y2, double thickness, uint32_t color, uint8_t alpha = 255);
 	void AddPixel(int x1, int y1, int palcolor, uint32_t color);
 
+	bool BeginDisplayList(FDisplayList &list, std::initializer_list<intptr_t> key);
+	void EndDisplayList(FDisplayList &list);
+	void MergeCommands();
+
 	void Clear();
 
 	bool mIsFirstPass = true;
@@ -161,6 +161,30 @@ FTexture * BuildTextTexture(FFont *font, const char *string, int textcolor)
 
 
 
+//==========================================================================
+//
+// Replaces a character's own texture with the font's atlas texture,
+// so that all characters of a string end up in the same draw command.
+// parms must already be set up for the character's texture.
+//
+//==========================================================================
+
+static FTexture *UseFontAtlas(FFont *font, int character, FTexture *pic, DrawParms &parms)
+{
+	// The window feature only works for full textures.
+	if (parms.windowleft > 0 || parms.windowright < parms.texwidth) return pic;
+
+	FloatRect rect;
+	FTexture *atlas = font->GetAtlasChar(character, pic, rect);
+	if (atlas == nullptr) return pic;
+
+	parms.srcx = rect.left + parms.srcx * rect.width;
+	parms.srcy = rect.top + parms.srcy * rect.height;
+	parms.srcwidth *= rect.width;
+	parms.srcheight *= rect.height;
+	return atlas;
+}
+
 //==========================================================================
 //
 // DrawChar
@@ -195,7 +219,7 @@ void DFrameBuffer::DrawChar (FFont *font, int normalcolor, double x, double y, i
 		PalEntry color = 0xffffffff;
 		parms.remap = redirected? nullptr : font->GetColorTranslation((EColorRange)normalcolor, &color);
 		parms.color = PalEntry((color.a * parms.color.a) / 255, (color.r * parms.color.r) / 255, (color.g * parms.color.g) / 255, (color.b * parms.color.b) / 255);
-		DrawTextureParms(pic, parms);
+		DrawTextureParms(UseFontAtlas(font, character, pic, parms), parms);
 	}
 }
 
@@ -220,7 +244,7 @@ void DFrameBuffer::DrawChar(FFont *font, int normalcolor, double x, double y, in
 		PalEntry color = 0xffffffff;
 		parms.remap = redirected ? nullptr : font->GetColorTranslation((EColorRange)normalcolor, &color);
 		parms.color = PalEntry((color.a * parms.color.a) / 255, (color.r * parms.color.r) / 255, (color.g * parms.color.g) / 255, (color.b * parms.color.b) / 255);
-		DrawTextureParms(pic, parms);
+		DrawTextureParms(UseFontAtlas(font, character, pic, parms), parms);
 	}
 }
 
@@ -333,7 +357,13 @@ void DFrameBuffer::DrawTextCommon(FFont *font, int normalcolor, double x, double
 			else if (parms.monospace == EMonospacing::CellRight)
 				parms.left = w;
 
-			DrawTextureParms(pic, parms);
+			// The source rectangle gets changed for the atlas so it needs to be restored for the next character.
+			double srcx = parms.srcx, srcy = parms.srcy, srcwidth = parms.srcwidth, srcheight = parms.srcheight;
+			DrawTextureParms(UseFontAtlas(font, c, pic, parms), parms);
+			parms.srcx = srcx;
+			parms.srcy = srcy;
+			parms.srcwidth = srcwidth;
+			parms.srcheight = srcheight;
 		}
 		if (parms.monospace == EMonospacing::Off)
 		{
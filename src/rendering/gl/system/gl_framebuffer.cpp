@@ -348,6 +348,11 @@ void OpenGLFrameBuffer::TextureFilterChanged()
 	if (GLRenderer != NULL && GLRenderer->mSamplerManager != NULL) GLRenderer->mSamplerManager->SetTextureFilterMode();
 }
 
+void OpenGLFrameBuffer::ResetTextureBindings()
+{
+	FHardwareTexture::UnbindAll();
+}
+
 void OpenGLFrameBuffer::BlurScene(float amount)
 {
 	GLRenderer->BlurScene(amount);
@@ -354,6 +354,7 @@ bool FHardwareTexture::BindOrCreate(FTexture *tex, int texunit, int clampmode, i
 			// could not create texture
 			return false;
 		}
+		if (!tex->isHardwareCanvas()) SetMemoryUsage(w, h, mipmapped);
 	}
 	if (tex->isHardwareCanvas()) static_cast<FCanvasTexture*>(tex)->NeedUpdate();
 	GLRenderer->mSamplerManager->Bind(texunit, clampmode, 255);
@@ -391,11 +391,44 @@ void FFlatVertexBuffer::Copy(int start, int count)
 //
 //==========================================================================
 
-void FFlatVertexBuffer::CreateVBO(TArray<sector_t> &sectors)
+void FFlatVertexBuffer::CreateWallSlots(TArray<seg_t> &segs, unsigned start)
+{
+	unsigned limit = BUFFER_SIZE_TO_USE > start + MIN_DYNAMIC_VERTICES ? BUFFER_SIZE_TO_USE - start - MIN_DYNAMIC_VERTICES : 0;
+	if (limit > MAX_STATIC_WALL_VERTICES) limit = MAX_STATIC_WALL_VERTICES;
+
+	auto sizes = BuildWallVertexSlots(segs);
+	mWallSlots.Resize(sizes.Size());
+
+	unsigned index = start;
+	for (unsigned i = 0; i < sizes.Size(); i++)
+	{
+		auto &slot = mWallSlots[i];
+		memset(&slot, 0, sizeof(slot));
+		if (sizes[i] > 0 && index + sizes[i] <= start + limit)
+		{
+			// Slots get filled on first use, all that's needed here is to reserve the space.
+			slot.vertindex = index;
+			slot.capacity = sizes[i];
+			slot.frame = ~0u;
+			index += sizes[i];
+		}
+	}
+	mIndex = index;
+}
+
+//==========================================================================
+//
+//
+//
+//==========================================================================
+
+void FFlatVertexBuffer::CreateVBO(TArray<sector_t> &sectors, TArray<seg_t> &segs)
 {
 	vbo_shadowdata.Resize(mNumReserved);
 	FFlatVertexBuffer::CreateVertices(sectors);
-	mCurIndex = mIndex = vbo_shadowdata.Size();
-	Copy(0, mIndex);
+	unsigned flatcount = vbo_shadowdata.Size();
+	CreateWallSlots(segs, flatcount);
+	mCurIndex = mIndex;
+	Copy(0, flatcount);
 	mIndexBuffer->SetData(ibo_data.Size() * sizeof(uint32_t), &ibo_data[0]);
 }
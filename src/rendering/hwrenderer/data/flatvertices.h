@@ -32,6 +32,7 @@
 class FRenderState;
 struct secplane_t;
 struct subsector_t;
+struct seg_t;
 
 struct FFlatVertex
 {
@@ -49,10 +50,38 @@ struct FFlatVertex
 	}
 };
 
+//==========================================================================
+//
+// Everything that determines the vertex data of a wall part.
+// If this is unchanged, the wall's static vertices can be reused as is.
+//
+//==========================================================================
+
+struct FWallVertexKey
+{
+	float x1, y1, x2, y2;
+	float fracleft, fracright;
+	float ztop[2], zbottom[2];
+	float tcs[8];
+	unsigned heightgen[2];	// height list generation of the linedef's vertices (for seamless splitting)
+	int flags;
+};
+
+struct FWallVertexSlot
+{
+	unsigned vertindex;		// start of this slot in the vertex buffer
+	unsigned capacity;		// 0 means that this wall part has no static storage.
+	unsigned vertcount;		// 0 means that the slot has not been filled yet.
+	unsigned frame;			// last frame this slot was used in. Slots may not be rewritten while in use.
+	FWallVertexKey key;
+};
+
 class FFlatVertexBuffer
 {
 	TArray<FFlatVertex> vbo_shadowdata;
 	TArray<uint32_t> ibo_data;
+	TArray<FWallVertexSlot> mWallSlots;
+	unsigned mWallFrame = 0;
 
 	IVertexBuffer *mVertexBuffer;
 	IIndexBuffer *mIndexBuffer;
@@ -64,6 +93,8 @@ class FFlatVertexBuffer
 
 	static const unsigned int BUFFER_SIZE = 2000000;
 	static const unsigned int BUFFER_SIZE_TO_USE = 1999500;
+	static const unsigned int MAX_STATIC_WALL_VERTICES = 600000;
+	static const unsigned int MIN_DYNAMIC_VERTICES = 1000000;
 
 public:
 	enum
@@ -86,7 +117,7 @@ public:
 		return std::make_pair(mVertexBuffer, mIndexBuffer);
 	}
 
-	void CreateVBO(TArray<sector_t> &sectors);
+	void CreateVBO(TArray<sector_t> &sectors, TArray<seg_t> &segs);
 	void Copy(int start, int count);
 
 	FFlatVertex *GetBuffer(int index) const
@@ -105,6 +136,19 @@ public:
 	void Reset()
 	{
 		mCurIndex = mIndex;
+		mWallFrame++;
+	}
+
+	FWallVertexSlot *GetWallSlot(int segnum, int part)
+	{
+		unsigned index = segnum * NUM_WALLPARTS + part;
+		if (index >= mWallSlots.Size() || mWallSlots[index].capacity == 0) return nullptr;
+		return &mWallSlots[index];
+	}
+
+	unsigned GetWallFrame() const
+	{
+		return mWallFrame;
 	}
 
 	void Map()
@@ -122,6 +166,7 @@ private:
 	int CreateIndexedSectorVertices(sector_t *sec, const secplane_t &plane, int floor, VertexContainer &cont);
 	int CreateIndexedVertices(int h, sector_t *sec, const secplane_t &plane, int floor, VertexContainers &cont);
 	void CreateIndexedFlatVertices(TArray<sector_t> &sectors);
+	void CreateWallSlots(TArray<seg_t> &segs, unsigned start);
 
 	void UpdatePlaneVertices(sector_t *sec, int plane);
 protected:
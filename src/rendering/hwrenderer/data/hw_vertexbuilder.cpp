@@ -146,3 +146,33 @@ TArray<VertexContainer> BuildVertices(TArray<sector_t> &sectors)
 	}
 	return verticesPerSector;
 }
+
+//==========================================================================
+//
+// Calculates the static vertex storage needed by each wall part.
+// This needs to be large enough for all possible splits so that
+// a moving sector never causes a wall to outgrow its slot.
+//
+//==========================================================================
+
+TArray<unsigned> BuildWallVertexSlots(TArray<seg_t> &segs)
+{
+	TArray<unsigned> sizes(segs.Size() * NUM_WALLPARTS, true);
+	for (unsigned i = 0; i < segs.Size(); i++)
+	{
+		auto seg = &segs[i];
+		unsigned size = 0;
+		if (seg->sidedef != nullptr && seg->linedef != nullptr)
+		{
+			// the 4 corners, the splits along the upper and lower edge and the splits for all heights at the vertices.
+			size = 4 + 2 * (seg->sidedef->numsegs - 1);
+			size += 2 * seg->linedef->v1->numsectors + 2 * seg->linedef->v2->numsectors;
+		}
+		// Upper and lower parts only exist on two-sided lines.
+		unsigned size2s = seg->backsector != nullptr ? size : 0;
+		sizes[i * NUM_WALLPARTS + WALLPART_TOP] = size2s;
+		sizes[i * NUM_WALLPARTS + WALLPART_MID] = size;
+		sizes[i * NUM_WALLPARTS + WALLPART_BOTTOM] = size2s;
+	}
+	return sizes;
+}
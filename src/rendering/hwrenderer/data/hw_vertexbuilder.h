@@ -1,6 +1,7 @@
 
 #include "tarray.h"
 struct vertex_t;
+struct seg_t;
 
 struct FQualifiedVertex
 {
@@ -66,4 +67,15 @@ using VertexContainers = TArray<VertexContainer>;
 
 VertexContainers BuildVertices(TArray<sector_t> &sectors);
 
+enum EWallPart
+{
+	WALLPART_TOP,
+	WALLPART_MID,
+	WALLPART_BOTTOM,
+
+	NUM_WALLPARTS
+};
+
+TArray<unsigned> BuildWallVertexSlots(TArray<seg_t> &segs);
+
 
@@ -37,87 +37,112 @@
 
 #include "hw_clipper.h"
 #include "g_levellocals.h"
+#include "hwrenderer/utility/hw_clock.h"
 
 unsigned Clipper::starttime;
 
 Clipper::Clipper()
 {
 	starttime++;
+	memset(coverage, 0, sizeof(coverage));
 }
 
 //-----------------------------------------------------------------------------
 //
-// RemoveRange
+// Clear
 //
 //-----------------------------------------------------------------------------
 
-void Clipper::RemoveRange(ClipNode * range)
+void Clipper::Clear()
 {
-	if (range == cliphead)
-	{
-		cliphead = cliphead->next;
-	}
-	else
-	{
-		if (range->prev) range->prev->next = range->next;
-		if (range->next) range->next->prev = range->prev;
-	}
-	
-	Free(range);
+	blocked = false;
+	ranges.Clear();
+	silhouette.Clear();
+	memset(coverage, 0, sizeof(coverage));
+	starttime++;
 }
 
 //-----------------------------------------------------------------------------
 //
-// Clear
+// SetSilhouette
 //
 //-----------------------------------------------------------------------------
 
-void Clipper::Clear()
+void Clipper::SetSilhouette()
 {
-	ClipNode *node = cliphead;
-	ClipNode *temp;
-	
-	blocked = false;
-	while (node != NULL)
+	silhouette = ranges;
+}
+
+//-----------------------------------------------------------------------------
+//
+// Coverage bins
+//
+// Bin i counts as covered if a single range contains both
+// i << BIN_SHIFT and (i+1) << BIN_SHIFT. This way two adjacent
+// covered bins always belong to the same range and IsCovered is
+// exactly equivalent to searching the range array.
+//
+//-----------------------------------------------------------------------------
+
+void Clipper::SetCoverage(angle_t start, angle_t end)
+{
+	if (start > (0xffffffffu << BIN_SHIFT)) return;					// no bin starts inside the range.
+	unsigned first = (start + (1u << BIN_SHIFT) - 1) >> BIN_SHIFT;	// first bin starting inside the range
+	unsigned last = end == ANGLE_MAX ? NUM_BINS : (end >> BIN_SHIFT);	// bins before this one are fully inside
+	for (unsigned i = first; i < last; i++)
 	{
-		temp = node;
-		node = node->next;
-		Free(temp);
+		coverage[i >> 6] |= uint64_t(1) << (i & 63);
 	}
-	node = silhouette;
+}
 
-	while (node != NULL)
+void Clipper::ClearCoverage(angle_t start, angle_t end)
+{
+	unsigned first = start >> BIN_SHIFT;
+	unsigned last = end >> BIN_SHIFT;
+	for (unsigned i = first; i <= last; i++)
 	{
-		temp = node;
-		node = node->next;
-		Free(temp);
+		coverage[i >> 6] &= ~(uint64_t(1) << (i & 63));
 	}
-	
-	cliphead = NULL;
-	silhouette = NULL;
-	starttime++;
+}
+
+bool Clipper::IsCovered(angle_t start, angle_t end) const
+{
+	unsigned first = start >> BIN_SHIFT;
+	unsigned last = end >> BIN_SHIFT;
+	unsigned firstword = first >> 6, lastword = last >> 6;
+	uint64_t firstmask = ~uint64_t(0) << (first & 63);
+	uint64_t lastmask = ~uint64_t(0) >> (63 - (last & 63));
+
+	if (firstword == lastword)
+	{
+		uint64_t mask = firstmask & lastmask;
+		return (coverage[firstword] & mask) == mask;
+	}
+	if ((coverage[firstword] & firstmask) != firstmask) return false;
+	for (unsigned i = firstword + 1; i < lastword; i++)
+	{
+		if (coverage[i] != ~uint64_t(0)) return false;
+	}
+	return (coverage[lastword] & lastmask) == lastmask;
 }
 
 //-----------------------------------------------------------------------------
 //
-// SetSilhouette
+// Returns the index of the first range whose end is >= angle.
+// Since the ranges are disjoint and sorted, the end points are sorted, too.
 //
 //-----------------------------------------------------------------------------
 
-void Clipper::SetSilhouette()
+unsigned Clipper::FindFirstEndingAfter(angle_t angle) const
 {
-	ClipNode *node = cliphead;
-	ClipNode *last = NULL;
-
-	while (node != NULL)
+	unsigned lo = 0, hi = ranges.Size();
+	while (lo < hi)
 	{
-		ClipNode *snode = NewRange(node->start, node->end);
-		if (silhouette == NULL) silhouette = snode;
-		snode->prev = last;
-		if (last != NULL) last->next = snode;
-		last = snode;
-		node = node->next;
+		unsigned mid = (lo + hi) >> 1;
+		if (ranges[mid].end < angle) lo = mid + 1;
+		else hi = mid;
 	}
+	return lo;
 }
 
 //-----------------------------------------------------------------------------
@@ -128,20 +153,22 @@ void Clipper::SetSilhouette()
 
 bool Clipper::IsRangeVisible(angle_t startAngle, angle_t endAngle)
 {
-	ClipNode *ci;
-	ci = cliphead;
-	
-	if (endAngle==0 && ci && ci->start==0) return false;
-	
-	while (ci != NULL && ci->start < endAngle)
+	clipper_checks++;
+	if (ranges.Size() == 0) return true;
+	if (endAngle==0 && ranges[0].start==0) return false;
+
+	if (IsCovered(startAngle, endAngle))
 	{
-		if (startAngle >= ci->start && endAngle <= ci->end)
-		{
-			return false;
-		}
-		ci = ci->next;
+		clipper_binrejects++;
+		return false;
+	}
+
+	// Only the first range not ending before endAngle can contain the entire range.
+	unsigned i = FindFirstEndingAfter(endAngle);
+	if (i < ranges.Size() && ranges[i].start <= startAngle && ranges[i].start < endAngle)
+	{
+		return false;
 	}
-	
 	return true;
 }
 
@@ -153,100 +180,26 @@ bool Clipper::IsRangeVisible(angle_t startAngle, angle_t endAngle)
 
 void Clipper::AddClipRange(angle_t start, angle_t end)
 {
-	ClipNode *node, *temp, *prevNode;
+	// All ranges from i to j-1 overlap or touch the new one and get merged with it.
+	unsigned i = FindFirstEndingAfter(start);
+	unsigned j = i;
+	while (j < ranges.Size() && ranges[j].start <= end)
+	{
+		if (ranges[j].end > end) end = ranges[j].end;
+		j++;
+	}
 
-	if (cliphead)
+	if (i == j)
 	{
-		//check to see if range contains any old ranges
-		node = cliphead;
-		while (node != NULL && node->start < end)
-		{
-			if (node->start >= start && node->end <= end)
-			{
-				temp = node;
-				node = node->next;
-				RemoveRange(temp);
-			}
-			else if (node->start<=start && node->end>=end)
-			{
-				return;
-			}
-			else
-			{
-				node = node->next;
-			}
-		}
-		
-		//check to see if range overlaps a range (or possibly 2)
-		node = cliphead;
-		while (node != NULL && node->start <= end)
-		{
-			if (node->end >= start)
-			{
-				// we found the first overlapping node
-				if (node->start > start)
-				{
-					// the new range overlaps with this node's start point
-					node->start = start;
-				}
-
-				if (node->end < end) 
-				{
-					node->end = end;
-				}
-
-				ClipNode *node2 = node->next;
-				while (node2 && node2->start <= node->end)
-				{
-					if (node2->end > node->end) node->end = node2->end;
-					ClipNode *delnode = node2;
-					node2 = node2->next;
-					RemoveRange(delnode);
-				}
-				return;
-			}
-			node = node->next;		
-		}
-		
-		//just add range
-		node = cliphead;
-		prevNode = NULL;
-		temp = NewRange(start, end);
-		
-		while (node != NULL && node->start < end)
-		{
-			prevNode = node;
-			node = node->next;
-		}
-		
-		temp->next = node;
-		if (node == NULL)
-		{
-			temp->prev = prevNode;
-			if (prevNode) prevNode->next = temp;
-			if (!cliphead) cliphead = temp;
-		}
-		else
-		{
-			if (node == cliphead)
-			{
-				cliphead->prev = temp;
-				cliphead = temp;
-			}
-			else
-			{
-				temp->prev = prevNode;
-				prevNode->next = temp;
-				node->prev = temp;
-			}
-		}
+		ranges.Insert(i, { start, end });
 	}
 	else
 	{
-		temp = NewRange(start, end);
-		cliphead = temp;
-		return;
+		if (ranges[i].start < start) start = ranges[i].start;
+		ranges[i] = { start, end };
+		if (j - i > 1) ranges.Delete(i + 1, j - i - 1);
 	}
+	SetCoverage(start, end);
 }
 
 
@@ -258,26 +211,24 @@ void Clipper::AddClipRange(angle_t start, angle_t end)
 
 void Clipper::RemoveClipRange(angle_t start, angle_t end)
 {
-	ClipNode *node;
-
-	if (silhouette)
+	if (silhouette.Size() > 0)
 	{
-		node = silhouette;
-		while (node != NULL && node->end <= start)
+		unsigned node = 0;
+		while (node < silhouette.Size() && silhouette[node].end <= start)
 		{
-			node = node->next;
+			node++;
 		}
-		if (node != NULL && node->start <= start)
+		if (node < silhouette.Size() && silhouette[node].start <= start)
 		{
-			if (node->end >= end) return;
-			start = node->end;
-			node = node->next;
+			if (silhouette[node].end >= end) return;
+			start = silhouette[node].end;
+			node++;
 		}
-		while (node != NULL && node->start < end)
+		while (node < silhouette.Size() && silhouette[node].start < end)
 		{
-			DoRemoveClipRange(start, node->start);
-			start = node->end;
-			node = node->next;
+			DoRemoveClipRange(start, silhouette[node].start);
+			start = silhouette[node].end;
+			node++;
 		}
 		if (start >= end) return;
 	}
@@ -292,51 +243,38 @@ void Clipper::RemoveClipRange(angle_t start, angle_t end)
 
 void Clipper::DoRemoveClipRange(angle_t start, angle_t end)
 {
-	ClipNode *node, *temp;
+	if (ranges.Size() == 0) return;
 
-	if (cliphead)
+	ClearCoverage(start, end);
+
+	unsigned i = FindFirstEndingAfter(start);
+	while (i < ranges.Size() && ranges[i].start <= end)
 	{
-		//check to see if range contains any old ranges
-		node = cliphead;
-		while (node != NULL && node->start < end)
+		auto &range = ranges[i];
+		if (range.start >= start && range.end <= end)
+		{
+			// completely inside the removed range
+			ranges.Delete(i);
+			continue;
+		}
+		else if (range.start < start && range.end > end)
+		{
+			// the removed range is in the middle of this one and splits it in two.
+			ClipRange after = { end, range.end };
+			range.end = start;
+			ranges.Insert(i + 1, after);
+			break;
+		}
+		else if (range.start >= start)
 		{
-			if (node->start >= start && node->end <= end)
-			{
-				temp = node;
-				node = node->next;
-				RemoveRange(temp);
-			}
-			else
-			{
-				node = node->next;
-			}
+			range.start = end;
+			break;
 		}
-		
-		//check to see if range overlaps a range (or possibly 2)
-		node = cliphead;
-		while (node != NULL)
+		else
 		{
-			if (node->start >= start && node->start <= end)
-			{
-				node->start = end;
-				break;
-			}
-			else if (node->end >= start && node->end <= end)
-			{
-				node->end=start;
-			}
-			else if (node->start < start && node->end > end)
-			{
-				temp = NewRange(end, node->end);
-				node->end=start;
-				temp->next=node->next;
-				temp->prev=node;
-				node->next=temp;
-				if (temp->next) temp->next->prev=temp;
-				break;
-			}
-			node = node->next;
+			range.end = start;
 		}
+		i++;
 	}
 }
 
@@ -4,37 +4,46 @@
 #include "doomtype.h"
 #include "xs_Float.h"
 #include "r_utility.h"
-#include "memarena.h"
+#include "tarray.h"
 
-class ClipNode
+struct ClipRange
 {
-	friend class Clipper;
-	
-	ClipNode *prev, *next;
 	angle_t start, end;
-
-	bool operator== (const ClipNode &other)
-	{
-		return other.start == start && other.end == end;
-	}
 };
 
+//-----------------------------------------------------------------------------
+//
+// The clip ranges are kept as a sorted array of disjoint ranges.
+// In addition a coarse coverage map of angle bins is maintained where a bit
+// is set if the entire bin is covered by a single clip range. This allows
+// rejecting most invisible segs and BSP nodes by testing 64 bins at once
+// without searching the range array.
+//
+//-----------------------------------------------------------------------------
 
 class Clipper
 {
+	enum
+	{
+		BIN_SHIFT = 20,
+		NUM_BINS = 1 << (32 - BIN_SHIFT),
+		NUM_BINWORDS = NUM_BINS / 64
+	};
+
 	static unsigned starttime;
-	FMemArena nodearena;
-	ClipNode * freelist = nullptr;
 
-	ClipNode * clipnodes = nullptr;
-	ClipNode * cliphead = nullptr;
-	ClipNode * silhouette = nullptr;	// will be preserved even when RemoveClipRange is called
+	TArray<ClipRange> ranges;
+	TArray<ClipRange> silhouette;	// will be preserved even when RemoveClipRange is called
+	uint64_t coverage[NUM_BINWORDS];
     const FRenderViewpoint *viewpoint = nullptr;
 	bool blocked = false;
 
 	static angle_t AngleToPseudo(angle_t ang);
 	bool IsRangeVisible(angle_t startangle, angle_t endangle);
-	void RemoveRange(ClipNode * cn);
+	bool IsCovered(angle_t startangle, angle_t endangle) const;
+	void SetCoverage(angle_t start, angle_t end);
+	void ClearCoverage(angle_t start, angle_t end);
+	unsigned FindFirstEndingAfter(angle_t angle) const;
 	void AddClipRange(angle_t startangle, angle_t endangle);
 	void RemoveClipRange(angle_t startangle, angle_t endangle);
 	void DoRemoveClipRange(angle_t start, angle_t end);
@@ -45,33 +54,6 @@ public:
 
 	void Clear();
 
-	void Free(ClipNode *node)
-	{
-		node->next = freelist;
-		freelist = node;
-	}
-
-	ClipNode * GetNew()
-	{
-		if (freelist)
-		{
-			ClipNode * p = freelist;
-			freelist = p->next;
-			return p;
-		}
-		else return (ClipNode*)nodearena.Alloc(sizeof(ClipNode));
-	}
-
-	ClipNode * NewRange(angle_t start, angle_t end)
-	{
-		ClipNode * c = GetNew();
-
-		c->start = start;
-		c->end = end;
-		c->next = c->prev = NULL;
-		return c;
-	}
-    
     void SetViewpoint(const FRenderViewpoint &vp)
     {
         viewpoint = &vp;
@@ -480,6 +480,7 @@ void HWDrawInfo::RenderScene(FRenderState &state)
 		drawlists[GLDL_MASKEDWALLS].SortWalls();
 		drawlists[GLDL_MASKEDFLATS].SortFlats();
 		drawlists[GLDL_MASKEDWALLSOFS].SortWalls();
+		drawlists[GLDL_MODELS].SortModels();
 	}
 
 	// Part 1: solid geometry. This is set up so that there are no transparent parts
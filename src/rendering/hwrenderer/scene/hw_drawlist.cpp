@@ -32,10 +32,12 @@
 #include "g_levellocals.h"
 #include "hwrenderer/scene/hw_drawstructs.h"
 #include "hwrenderer/scene/hw_drawlist.h"
+#include "r_data/models/models.h"
 #include "hwrenderer/data/flatvertices.h"
 #include "hwrenderer/utility/hw_clock.h"
 #include "hw_renderstate.h"
 #include "hw_drawinfo.h"
+#include "hwrenderer/textures/hw_texcontainer.h"
 #include "hw_fakeflat.h"
 
 FMemArena RenderDataAllocator(1024*1024);	// Use large blocks to reduce allocation time.
@@ -82,6 +84,7 @@ void HWDrawList::Reset()
 {
 	if (sorted) SortNodes.Release(SortNodeStart);
 	sorted=NULL;
+	sortgroups.Clear();
 	walls.Clear();
 	flats.Clear();
 	sprites.Clear();
@@ -158,21 +161,20 @@ inline void SortNode::AddToRight(SortNode * child)
 //
 //
 //==========================================================================
-void HWDrawList::MakeSortList()
+SortNode * HWDrawList::MakeSortList(const TArray<int> &items)
 {
-	SortNode * p, * n, * c;
+	SortNode * p, * n, * c, * head;
 	unsigned i;
 
-	SortNodeStart=SortNodes.Size();
 	p=NULL;
-	n=SortNodes.GetNew();
-	for(i=0;i<drawitems.Size();i++)
+	head=n=SortNodes.GetNew();
+	for(i=0;i<items.Size();i++)
 	{
-		n->itemindex=(int)i;
+		n->itemindex=items[i];
 		n->left=n->equal=n->right=NULL;
 		n->parent=p;
 		p=n;
-		if (i!=drawitems.Size()-1)
+		if (i!=items.Size()-1)
 		{
 			c=SortNodes.GetNew();
 			n->next=c;
@@ -183,6 +185,193 @@ void HWDrawList::MakeSortList()
 			n->next=NULL;
 		}
 	}
+	return head;
+}
+
+//==========================================================================
+//
+// Translucent items whose horizontal view angle ranges do not overlap
+// cannot overlap on screen either, regardless of pitch and roll, so
+// they do not need any ordering relative to each other.
+// This splits the list into such independent groups so that geometry
+// only gets split against splitters it actually can be in conflict with.
+//
+//==========================================================================
+
+struct SortAngleRange
+{
+	double lo, hi;
+	int item;
+};
+
+static void AddSortRange(TArray<SortAngleRange> &ranges, double lo, double hi, int item)
+{
+	const double eps = 1. / 1024;	// be generous with precision problems.
+	lo -= eps;
+	hi += eps;
+	if (hi - lo >= 2 * M_PI)
+	{
+		ranges.Push({ -M_PI, M_PI, item });
+	}
+	else if (lo < -M_PI)
+	{
+		ranges.Push({ lo + 2 * M_PI, M_PI, item });
+		ranges.Push({ -M_PI, hi, item });
+	}
+	else if (hi > M_PI)
+	{
+		ranges.Push({ lo, M_PI, item });
+		ranges.Push({ -M_PI, hi - 2 * M_PI, item });
+	}
+	else
+	{
+		ranges.Push({ lo, hi, item });
+	}
+}
+
+// Angle relative to the view direction, in the range [-pi, pi]. The seam is directly behind the viewer.
+static inline double RelativeAngle(const FRenderViewpoint &vp, double x, double y)
+{
+	double a = atan2(y - vp.Pos.Y, x - vp.Pos.X) - vp.Angles.Yaw.Radians();
+	while (a > M_PI) a -= 2 * M_PI;
+	while (a < -M_PI) a += 2 * M_PI;
+	return a;
+}
+
+static void AddSortPoints(TArray<SortAngleRange> &ranges, const FRenderViewpoint &vp, double cx, double cy, const DVector2 *points, int count, int item)
+{
+	double center = RelativeAngle(vp, cx, cy);
+	double lo = 0, hi = 0;
+	for (int i = 0; i < count; i++)
+	{
+		double d = RelativeAngle(vp, points[i].X, points[i].Y) - center;
+		if (d > M_PI) d -= 2 * M_PI;
+		if (d < -M_PI) d += 2 * M_PI;
+		lo = MIN(lo, d);
+		hi = MAX(hi, d);
+	}
+	AddSortRange(ranges, center + lo, center + hi, item);
+}
+
+static int FindGroupRoot(TArray<int> &groupof, int i)
+{
+	while (groupof[i] != i)
+	{
+		groupof[i] = groupof[groupof[i]];
+		i = groupof[i];
+	}
+	return i;
+}
+
+int HWDrawList::FindSortGroups(HWDrawInfo *di, TArray<int> &groupof)
+{
+	static TArray<SortAngleRange> ranges;
+	auto &vp = di->Viewpoint;
+	DVector2 viewpos = vp.Pos.XY();
+	unsigned count = drawitems.Size();
+
+	ranges.Clear();
+	for (unsigned i = 0; i < count; i++)
+	{
+		auto &item = drawitems[i];
+		switch (item.rendertype)
+		{
+		case DrawType_WALL:
+		{
+			HWWall *w = walls[item.index];
+			DVector2 v[2] = { { w->glseg.x1, w->glseg.y1 }, { w->glseg.x2, w->glseg.y2 } };
+			// A segment not passing through the view point never covers more than 180 degrees.
+			DVector2 delta = v[1] - v[0];
+			double len = delta.Length();
+			DVector2 rel = viewpos - v[0];
+			if (len == 0 || fabs(rel.X * delta.Y - rel.Y * delta.X) / len < 1.)
+			{
+				AddSortRange(ranges, -M_PI, M_PI, i);
+			}
+			else
+			{
+				DVector2 c = (v[0] + v[1]) / 2;
+				AddSortPoints(ranges, vp, c.X, c.Y, v, 2, i);
+			}
+			break;
+		}
+
+		case DrawType_FLAT:
+		{
+			HWFlat *f = flats[item.index];
+			if (f->section == nullptr || f->hacktype || f->section->bounds.contains(viewpos.X, viewpos.Y))
+			{
+				AddSortRange(ranges, -M_PI, M_PI, i);
+			}
+			else
+			{
+				auto &b = f->section->bounds;
+				DVector2 v[4] = { { b.left, b.top }, { b.right, b.top }, { b.right, b.bottom }, { b.left, b.bottom } };
+				AddSortPoints(ranges, vp, (b.left + b.right) / 2, (b.top + b.bottom) / 2, v, 4, i);
+			}
+			break;
+		}
+
+		case DrawType_SPRITE:
+		{
+			// Sprites can be rotated around their origin in several ways so use a circle that covers all possibilities.
+			HWSprite *s = sprites[item.index];
+			DVector2 center(s->x, s->y);
+			double radius = MAX(fabs(s->x1 - s->x), fabs(s->x2 - s->x)) + MAX(fabs(s->y1 - s->y), fabs(s->y2 - s->y)) + fabs(s->z2 - s->z1);
+			double dist = (center - viewpos).Length();
+			if (s->modelframe || dist <= radius + 1.)
+			{
+				AddSortRange(ranges, -M_PI, M_PI, i);
+			}
+			else
+			{
+				double a = RelativeAngle(vp, center.X, center.Y);
+				double half = asin(radius / dist);
+				AddSortRange(ranges, a - half, a + half, i);
+			}
+			break;
+		}
+		}
+	}
+
+	groupof.Resize(count);
+	for (unsigned i = 0; i < count; i++) groupof[i] = i;
+
+	std::sort(ranges.begin(), ranges.end(), [](const SortAngleRange &a, const SortAngleRange &b) { return a.lo < b.lo; });
+	double runend = -FLT_MAX;
+	int runitem = -1;
+	for (auto &r : ranges)
+	{
+		if (r.lo > runend)
+		{
+			runitem = r.item;
+			runend = r.hi;
+		}
+		else
+		{
+			int a = FindGroupRoot(groupof, runitem);
+			int b = FindGroupRoot(groupof, r.item);
+			if (a != b) groupof[b] = a;
+			runend = MAX(runend, r.hi);
+		}
+	}
+
+	// Turn the roots into consecutive group numbers, ordered by each group's first item.
+	static TArray<int> roots, groupnum;
+	roots.Resize(count);
+	groupnum.Resize(count);
+	for (unsigned i = 0; i < count; i++)
+	{
+		roots[i] = FindGroupRoot(groupof, i);
+		groupnum[i] = -1;
+	}
+	int numgroups = 0;
+	for (unsigned i = 0; i < count; i++)
+	{
+		if (groupnum[roots[i]] < 0) groupnum[roots[i]] = numgroups++;
+		groupof[i] = groupnum[roots[i]];
+	}
+	return numgroups;
 }
 
 
@@ -702,47 +891,169 @@ SortNode * HWDrawList::DoSort(HWDrawInfo *di, SortNode * head)
 //==========================================================================
 void HWDrawList::Sort(HWDrawInfo *di)
 {
+	static TArray<int> groupof;
+	static TArray<int> items;
+
 	reverseSort = !!(di->Level->i_compatflags & COMPATF_SPRITESORT);
     SortZ = di->Viewpoint.Pos.Z;
-	MakeSortList();
-	sorted = DoSort(di, SortNodes[SortNodeStart]);
+	SortNodeStart = SortNodes.Size();
+	sortgroups.Clear();
+
+	// DoSort can append new items so everything needs to be grouped up front.
+	unsigned count = drawitems.Size();
+	int numgroups = FindSortGroups(di, groupof);
+	for (int g = 0; g < numgroups; g++)
+	{
+		items.Clear();
+		for (unsigned i = 0; i < count; i++)
+		{
+			if (groupof[i] == g) items.Push(i);
+		}
+		sortgroups.Push(DoSort(di, MakeSortList(items)));
+	}
+	render_sortgroups += numgroups;
+	sorted = sortgroups[0];
 }
 
 //==========================================================================
 //
-// Sorting the drawitems first by texture and then by light level
+// Sorts the draw items by packed 64 bit keys. The lowest 24 bits of
+// each key must be the item's index in the list, which makes all
+// keys unique and the sort stable.
+// This is a plain LSD radix sort that skips all bytes which are
+// identical for all keys - with the typical key layout most of
+// them are.
 //
 //==========================================================================
 
-void HWDrawList::SortWalls()
+void HWDrawList::SortByKeys(TArray<uint64_t> &keys)
 {
-	if (drawitems.Size() > 1)
+	static TArray<uint64_t> temp;
+	unsigned counts[8][256];
+	unsigned count = keys.Size();
+
+	memset(counts, 0, sizeof(counts));
+	for (auto key : keys)
 	{
-		std::sort(drawitems.begin(), drawitems.end(), [=](const HWDrawItem &a, const HWDrawItem &b) -> bool
+		for (int b = 0; b < 8; b++) counts[b][(key >> (b * 8)) & 255]++;
+	}
+
+	temp.Resize(count);
+	uint64_t *src = keys.Data(), *dst = temp.Data();
+	for (int b = 0; b < 8; b++)
+	{
+		unsigned *c = counts[b];
+		if (c[(src[0] >> (b * 8)) & 255] == count) continue;	// all keys are equal in this byte.
+
+		unsigned offset = 0;
+		for (int i = 0; i < 256; i++)
+		{
+			unsigned n = c[i];
+			c[i] = offset;
+			offset += n;
+		}
+		for (unsigned i = 0; i < count; i++)
 		{
-			HWWall * w1 = walls[a.index];
-			HWWall * w2 = walls[b.index];
+			dst[c[(src[i] >> (b * 8)) & 255]++] = src[i];
+		}
+		std::swap(src, dst);
+	}
 
-			if (w1->gltexture != w2->gltexture) return w1->gltexture < w2->gltexture;
-			return (w1->flags & 3) < (w2->flags & 3);
+	static TArray<HWDrawItem> sorteditems;
+	sorteditems.Clear();
+	for (unsigned i = 0; i < count; i++)
+	{
+		sorteditems.Push(drawitems[src[i] & 0xffffff]);
+	}
+	memcpy(drawitems.Data(), sorteditems.Data(), count * sizeof(HWDrawItem));
+}
+
+//==========================================================================
+//
+// Key layout: shader (8 bits), texture (24 bits), render state (8 bits), item index (24 bits)
+//
+//==========================================================================
 
-		});
+static inline uint64_t MakeSortKey(FMaterial *mat, int state, unsigned index)
+{
+	uint64_t shader = 0, tex = 0;
+	if (mat != nullptr)
+	{
+		shader = MIN(mat->GetShaderIndex(), 255);
+		tex = (mat->tex->GetID().GetIndex() + 1) & 0xffffff;
+	}
+	return (shader << 56) | (tex << 32) | (uint64_t(state & 255) << 24) | index;
+}
+
+//==========================================================================
+//
+// Sorting the drawitems first by texture and then by light level
+//
+//==========================================================================
+
+void HWDrawList::SortWalls()
+{
+	unsigned count = drawitems.Size();
+	if (count > 1 && count <= 0xffffff)
+	{
+		static TArray<uint64_t> keys;
+		keys.Resize(count);
+		for (unsigned i = 0; i < count; i++)
+		{
+			HWWall *w = walls[drawitems[i].index];
+			keys[i] = MakeSortKey(w->gltexture, w->flags & 3, i);
+		}
+		SortByKeys(keys);
 	}
 }
 
 void HWDrawList::SortFlats()
 {
-	if (drawitems.Size() > 1)
+	unsigned count = drawitems.Size();
+	if (count > 1 && count <= 0xffffff)
 	{
-		std::sort(drawitems.begin(), drawitems.end(), [=](const HWDrawItem &a, const HWDrawItem &b)
+		static TArray<uint64_t> keys;
+		keys.Resize(count);
+		for (unsigned i = 0; i < count; i++)
 		{
-			HWFlat * w1 = flats[a.index];
-			HWFlat* w2 = flats[b.index];
-			return w1->gltexture < w2->gltexture;
-		});
+			keys[i] = MakeSortKey(flats[drawitems[i].index]->gltexture, 0, i);
+		}
+		SortByKeys(keys);
 	}
 }
 
+//==========================================================================
+//
+// Groups the opaque models so that actors sharing the same model frame
+// and translation get drawn back to back. This lets the render state skip
+// rebinding the vertex buffer and the skin between them.
+// Key layout: model frame (24 bits), translation index (16 bits), item index (24 bits)
+// The translation index is the one the skins get cached by, so translations
+// with identical tables also end up together.
+//
+//==========================================================================
+
+void HWDrawList::SortModels()
+{
+	unsigned count = drawitems.Size();
+	if (count > 1 && count <= 0xffffff)
+	{
+		static TArray<uint64_t> keys;
+		keys.Resize(count);
+		for (unsigned i = 0; i < count; i++)
+		{
+			uint64_t frame = 0, translation = 0;
+			if (drawitems[i].rendertype == DrawType_SPRITE)
+			{
+				HWSprite *s = sprites[drawitems[i].index];
+				frame = (uintptr_t(s->modelframe) / sizeof(FSpriteModelFrame)) & 0xffffff;
+				translation = FHardwareTextureContainer::TranslationToIndex(s->translation) & 0xffff;
+			}
+			keys[i] = (frame << 40) | (translation << 24) | i;
+		}
+		SortByKeys(keys);
+	}
+}
 
 //==========================================================================
 //
@@ -840,9 +1151,18 @@ void HWDrawList::Draw(HWDrawInfo *di, FRenderState &state, bool translucent)
 void HWDrawList::DrawWalls(HWDrawInfo *di, FRenderState &state, bool translucent)
 {
 	RenderWall.Clock();
+	FMaterial *lastmat = nullptr;
+	int lastflags = -1;
 	for (auto &item : drawitems)
 	{
-		walls[item.index]->DrawWall(di, state, translucent);
+		HWWall *w = walls[item.index];
+		if (w->gltexture != lastmat || (w->flags & 3) != lastflags)
+		{
+			render_statechanges++;
+			lastmat = w->gltexture;
+			lastflags = w->flags & 3;
+		}
+		w->DrawWall(di, state, translucent);
 	}
 	RenderWall.Unclock();
 }
@@ -855,9 +1175,16 @@ void HWDrawList::DrawWalls(HWDrawInfo *di, FRenderState &state, bool translucent
 void HWDrawList::DrawFlats(HWDrawInfo *di, FRenderState &state, bool translucent)
 {
 	RenderFlat.Clock();
+	FMaterial *lastmat = nullptr;
 	for (unsigned i = 0; i<drawitems.Size(); i++)
 	{
-		flats[drawitems[i].index]->DrawFlat(di, state, translucent);
+		HWFlat *f = flats[drawitems[i].index];
+		if (f->gltexture != lastmat || i == 0)
+		{
+			render_statechanges++;
+			lastmat = f->gltexture;
+		}
+		f->DrawFlat(di, state, translucent);
 	}
 	RenderFlat.Unclock();
 }
@@ -940,7 +1267,10 @@ void HWDrawList::DrawSorted(HWDrawInfo *di, FRenderState &state)
 	state.ClearClipSplit();
 	state.EnableClipDistance(1, true);
 	state.EnableClipDistance(2, true);
-	DrawSorted(di, state, sorted);
+	for (auto group : sortgroups)
+	{
+		DrawSorted(di, state, group);
+	}
 	state.EnableClipDistance(1, false);
 	state.EnableClipDistance(2, false);
 	state.ClearClipSplit();
@@ -64,6 +64,7 @@ struct HWDrawList
 	TArray<HWFlat*> flats;
 	TArray<HWSprite*> sprites;
 	TArray<HWDrawItem> drawitems;
+	TArray<SortNode*> sortgroups;	// independent translucent sort trees that cannot overlap on screen.
 	int SortNodeStart;
     float SortZ;
 	SortNode * sorted;
@@ -93,9 +94,12 @@ public:
 	void Reset();
 	void SortWalls();
 	void SortFlats();
+	void SortModels();
+	void SortByKeys(TArray<uint64_t> &keys);
 	
 	
-	void MakeSortList();
+	SortNode * MakeSortList(const TArray<int> &items);
+	int FindSortGroups(HWDrawInfo *di, TArray<int> &groupof);
 	SortNode * FindSortPlane(SortNode * head);
 	SortNode * FindSortWall(SortNode * head);
 	void SortPlaneIntoPlane(SortNode * head,SortNode * sort);
@@ -211,6 +211,7 @@ public:
 	void SetupLights(HWDrawInfo *di, FDynLightData &lightdata);
 
 	void MakeVertices(HWDrawInfo *di, bool nosplit);
+	bool GetStaticVertices(bool split);
 
 	void SkyPlane(HWDrawInfo *di, sector_t *sector, int plane, bool allowmirror);
 	void SkyLine(HWDrawInfo *di, sector_t *sec, line_t *line);
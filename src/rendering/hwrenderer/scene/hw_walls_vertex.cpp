@@ -27,6 +27,7 @@
 #include "hwrenderer/scene/hw_drawstructs.h"
 
 EXTERN_CVAR(Bool, gl_seamless)
+EXTERN_CVAR(Bool, gl_staticwalls)
 
 //==========================================================================
 //
@@ -256,6 +257,80 @@ int HWWall::CountVertices()
 	return (int)ptr;
 }
 
+//==========================================================================
+//
+// Tries to use the wall's static vertex slot instead of allocating
+// from the dynamic part of the buffer. The slot's content only gets
+// rewritten if something affecting the geometry has changed.
+//
+//==========================================================================
+
+bool HWWall::GetStaticVertices(bool split)
+{
+	int part;
+	switch (type)
+	{
+	case RENDERWALL_TOP:
+		part = WALLPART_TOP;
+		break;
+
+	case RENDERWALL_M1S:
+	case RENDERWALL_M2S:
+	case RENDERWALL_M2SNF:
+		part = WALLPART_MID;
+		break;
+
+	case RENDERWALL_BOTTOM:
+		part = WALLPART_BOTTOM;
+		break;
+
+	default:
+		return false;
+	}
+	if (seg->sidedef == nullptr || (seg->sidedef->Flags & WALLF_POLYOBJ)) return false;
+
+	auto vbo = screen->mVertexData;
+	auto slot = vbo->GetWallSlot(seg->Index(), part);
+	if (slot == nullptr) return false;
+
+	FWallVertexKey key;
+	memset(&key, 0, sizeof(key));
+	key.x1 = glseg.x1;
+	key.y1 = glseg.y1;
+	key.x2 = glseg.x2;
+	key.y2 = glseg.y2;
+	key.fracleft = glseg.fracleft;
+	key.fracright = glseg.fracright;
+	for (int i = 0; i < 2; i++)
+	{
+		key.ztop[i] = ztop[i];
+		key.zbottom[i] = zbottom[i];
+		key.heightgen[i] = vertexes[i] ? vertexes[i]->heightgen : 0;
+	}
+	for (int i = 0; i < 4; i++)
+	{
+		key.tcs[i * 2] = tcs[i].u;
+		key.tcs[i * 2 + 1] = tcs[i].v;
+	}
+	key.flags = (flags & (HWF_NOSPLITUPPER | HWF_NOSPLITLOWER)) | (split ? 0x100 : 0);
+
+	unsigned frame = vbo->GetWallFrame();
+	if (slot->vertcount == 0 || memcmp(&key, &slot->key, sizeof(key)))
+	{
+		// Another piece of the same wall part (e.g. split by 3D floors or sorting) already uses this slot in the current frame.
+		if (slot->frame == frame) return false;
+		if (split && (unsigned)CountVertices() > slot->capacity) return false;
+
+		auto ptr = vbo->GetBuffer(slot->vertindex);
+		slot->vertcount = CreateVertices(ptr, split);
+		slot->key = key;
+	}
+	slot->frame = frame;
+	vertindex = slot->vertindex;
+	vertcount = slot->vertcount;
+	return true;
+}
+
 //==========================================================================
 //
 // build the vertices for this wall
@@ -267,6 +342,7 @@ void HWWall::MakeVertices(HWDrawInfo *di, bool nosplit)
 	if (vertcount == 0)
 	{
 		bool split = (gl_seamless && !nosplit && seg->sidedef != nullptr && !(seg->sidedef->Flags & WALLF_POLYOBJ) && !(flags & HWF_NOSPLIT));
+		if (gl_staticwalls && GetStaticVertices(split)) return;
 		auto ret = screen->mVertexData->AllocVertices(split ? CountVertices() : 4);
 		vertindex = ret.second;
 		vertcount = CreateVertices(ret.first, split);
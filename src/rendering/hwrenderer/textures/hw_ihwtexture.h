@@ -15,7 +15,7 @@ public:
 	};
 
 	IHardwareTexture() {}
-	virtual ~IHardwareTexture() {}
+	virtual ~IHardwareTexture();
 
 	virtual void DeleteDescriptors() { }
 
@@ -27,6 +27,24 @@ public:
 
 	int GetBufferPitch() const { return bufferpitch; }
 
+	// Residency tracking for gl_texture_budget. See hw_material.cpp.
+	void SetMemoryUsage(int w, int h, bool mipmapped);
+	void MarkUsed(FTexture *owner);
+	static void EvictUnused();
+	static void UpdateStreamedTextures();
+	static size_t GetResidentMemory();
+	static int GetResidentCount();
+	bool IsResident() const { return MemoryUsage > 0; }
+
 protected:
 	int bufferpitch = -1;
+
+private:
+	void Unlink();
+
+	IHardwareTexture *ResidentPrev = nullptr;
+	IHardwareTexture *ResidentNext = nullptr;
+	FTexture *Owner = nullptr;		// the texture whose SystemTextures holds this. nullptr while not in the residency list.
+	size_t MemoryUsage = 0;			// 0 for anything without uploaded texture data, e.g. canvases. Those never get evicted.
+	int LastUsed = 0;
 };
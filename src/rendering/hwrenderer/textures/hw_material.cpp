@@ -30,6 +30,7 @@
 #include "hw_material.h"
 
 EXTERN_CVAR(Bool, gl_texture_usehires)
+EXTERN_CVAR(Int, gl_texture_budget)
 
 //===========================================================================
 // 
@@ -128,6 +129,135 @@ void IHardwareTexture::Resize(int swidth, int sheight, int width, int height, un
 	}
 }
 
+//===========================================================================
+//
+// Texture residency
+//
+// All hardware textures that got used for rendering are kept in a list
+// ordered by last use. If gl_texture_budget is set, the least recently
+// used ones get deleted at the start of a frame until the total is below
+// the budget again. Anything used in the previous frame is never evicted,
+// so the budget may be exceeded if a single frame needs more than that.
+// Evicted textures simply get recreated by the next FMaterial::GetLayer call.
+//
+//===========================================================================
+
+static IHardwareTexture *ResidentHead, *ResidentTail;	// head is the most recently used one.
+static size_t ResidentMemory;
+static int ResidentCount;
+static int ResidencyFrame = 1;
+
+IHardwareTexture::~IHardwareTexture()
+{
+	Unlink();
+}
+
+void IHardwareTexture::Unlink()
+{
+	if (Owner == nullptr) return;
+	if (ResidentPrev) ResidentPrev->ResidentNext = ResidentNext;
+	else ResidentHead = ResidentNext;
+	if (ResidentNext) ResidentNext->ResidentPrev = ResidentPrev;
+	else ResidentTail = ResidentPrev;
+	ResidentPrev = ResidentNext = nullptr;
+	ResidentMemory -= MemoryUsage;
+	ResidentCount--;
+	Owner = nullptr;
+}
+
+void IHardwareTexture::SetMemoryUsage(int w, int h, bool mipmapped)
+{
+	size_t bytes = size_t(w) * h * 4;
+	if (mipmapped) bytes += bytes / 3;
+	if (Owner != nullptr) ResidentMemory += bytes - MemoryUsage;
+	MemoryUsage = bytes;
+}
+
+void IHardwareTexture::MarkUsed(FTexture *owner)
+{
+	LastUsed = ResidencyFrame;
+	if (ResidentHead == this) return;
+	if (Owner != nullptr)
+	{
+		Unlink();
+	}
+	Owner = owner;
+	ResidentPrev = nullptr;
+	ResidentNext = ResidentHead;
+	if (ResidentHead) ResidentHead->ResidentPrev = this;
+	else ResidentTail = this;
+	ResidentHead = this;
+	ResidentMemory += MemoryUsage;
+	ResidentCount++;
+}
+
+void IHardwareTexture::EvictUnused()
+{
+	ResidencyFrame++;
+	if (gl_texture_budget <= 0) return;
+
+	size_t budget = size_t(gl_texture_budget) << 20;
+	int evicted = 0;
+	for (auto hwtex = ResidentTail; hwtex != nullptr && ResidentMemory > budget; )
+	{
+		auto prev = hwtex->ResidentPrev;
+		// Everything from here on was used in the last frame.
+		if (hwtex->LastUsed >= ResidencyFrame - 1) break;
+		if (hwtex->MemoryUsage > 0)
+		{
+			hwtex->Owner->SystemTextures.DeleteHardwareTexture(hwtex);
+			evicted++;
+		}
+		hwtex = prev;
+	}
+	// The renderer may still hold references to the deleted textures.
+	if (evicted > 0) screen->ResetTextureBindings();
+}
+
+//===========================================================================
+//
+// Deletes the stand-ins of streamed textures whose full version is ready,
+// so that it gets picked up the next time they are used.
+// See FTexture::UpdateStreaming.
+//
+//===========================================================================
+
+void IHardwareTexture::UpdateStreamedTextures()
+{
+	TArray<FTexBufferRequest> finished;
+	FTexture::UpdateStreaming(finished);
+
+	int replaced = 0;
+	for (auto &req : finished)
+	{
+		// The request's translation already is an index, which the container takes as a negative value.
+		auto hwtex = req.tex->SystemTextures.GetHardwareTexture(-req.translation, !!(req.flags & CTF_Expand));
+		if (hwtex != nullptr)
+		{
+			req.tex->SystemTextures.DeleteHardwareTexture(hwtex);
+			replaced++;
+		}
+	}
+	if (replaced > 0) screen->ResetTextureBindings();
+}
+
+size_t IHardwareTexture::GetResidentMemory()
+{
+	return ResidentMemory;
+}
+
+int IHardwareTexture::GetResidentCount()
+{
+	return ResidentCount;
+}
+
+ADD_STAT(texturebudget)
+{
+	FString out;
+	out.Format("%d textures, %.1f MB resident, budget %d MB", ResidentCount, ResidentMemory / 1048576., *gl_texture_budget);
+	return out;
+}
+
 //===========================================================================
 //
 // Constructor
@@ -402,6 +532,17 @@ IHardwareTexture *FMaterial::GetLayer(int i, int translation, FTexture **pLayer)
 			hwtex = screen->CreateHardwareTexture();
 			layer->SystemTextures.AddHardwareTexture(translation, mExpanded, hwtex);
  		}
+		hwtex->MarkUsed(layer);
+		if (i == 0)
+		{
+			// Some backends only look up the other layers when creating a descriptor set for the material,
+			// so they need to be marked here to keep them from getting evicted while still in use.
+			for (auto ltex : mTextureLayers)
+			{
+				IHardwareTexture *lhwtex = ltex ? ltex->SystemTextures.GetHardwareTexture(0, mExpanded) : nullptr;
+				if (lhwtex) lhwtex->MarkUsed(ltex);
+			}
+		}
 		return hwtex;
 	}
 	return nullptr;
@@ -36,6 +36,12 @@
 #include "image.h"
 #include "v_video.h"
 #include "v_font.h"
+#include "hwrenderer/utility/hw_cvars.h"
+#include "stats.h"
+
+EXTERN_CVAR(Int, gl_texture_hqresizemode)
+EXTERN_CVAR(Int, gl_texture_hqresizemult)
+EXTERN_CVAR(Bool, gl_texture_hqresize_cache)
 
 
 //==========================================================================
@@ -65,6 +71,80 @@ static void PrecacheSprite(FTexture *tex, SpriteHits &hits)
 	if (gltex) gltex->PrecacheList(hits);
 }
 
+//==========================================================================
+//
+// Stop precaching once the texture budget is used up.
+// Everything else will be created when it's first needed.
+//
+//==========================================================================
+
+static bool OverBudget()
+{
+	return gl_texture_budget > 0 && IHardwareTexture::GetResidentMemory() >= (size_t(gl_texture_budget) << 20);
+}
+
+//==========================================================================
+//
+// Creates the texture data for a batch of materials on all cores
+// and then uploads it. The batches keep the amount of memory held
+// by prepared but not yet uploaded textures in check.
+//
+//==========================================================================
+
+struct FPrecacheItem
+{
+	FTexture *tex;
+	SpriteHits *hits;	// nullptr for walls, flats and skies.
+};
+
+enum
+{
+	PRECACHE_BATCH = 64
+};
+
+static void AddTexBufferRequest(TArray<FTexBufferRequest> &requests, FMaterial *mat, int translation)
+{
+	auto tex = mat->tex;
+	if (tex->isSWCanvas() || tex->isHardwareCanvas() || tex->GetImage() == nullptr) return;
+
+	auto hwtex = tex->SystemTextures.GetHardwareTexture(translation, mat->isExpanded());
+	if (hwtex != nullptr && hwtex->IsResident()) return;
+
+	// Same as what the backends' PrecacheMaterial implementations pass to CreateTexBuffer.
+	int flags = mat->isExpanded() ? CTF_Expand : (gl_texture_usehires && !tex->isScaled()) ? CTF_CheckHires : 0;
+	requests.Push({ tex, FHardwareTextureContainer::TranslationToIndex(translation), flags | CTF_ProcessData });
+}
+
+static void PrecacheBatch(FPrecacheItem *items, unsigned count)
+{
+	TArray<FTexBufferRequest> requests;
+	for (unsigned i = 0; i < count; i++)
+	{
+		FMaterial *mat = FMaterial::ValidateTexture(items[i].tex, items[i].hits != nullptr);
+		if (mat == nullptr) continue;
+
+		if (items[i].hits == nullptr)
+		{
+			AddTexBufferRequest(requests, mat, 0);
+		}
+		else
+		{
+			SpriteHits::Iterator it(*items[i].hits);
+			SpriteHits::Pair *pair;
+			while (it.NextPair(pair)) AddTexBufferRequest(requests, mat, pair->Key);
+		}
+	}
+	FTexture::PrepareTexBuffers(requests);
+
+	for (unsigned i = 0; i < count && !OverBudget(); i++)
+	{
+		if (items[i].hits == nullptr) PrecacheTexture(items[i].tex, FTextureManager::HIT_Wall);
+		else PrecacheSprite(items[i].tex, *items[i].hits);
+	}
+	// Anything that didn't get uploaded because of the texture budget will be created on demand later.
+	FTexture::ReleasePreparedTexBuffers();
+}
+
 //==========================================================================
 //
 // DFrameBuffer :: Precache
@@ -246,19 +326,29 @@ void hw_PrecacheTexture(uint8_t *texhitlist, TMap<PClassActor*, bool> &actorhitl
 			}
 		}
 
-		// cache all used textures
+		// cache all used textures. Walls, flats and skies go first so that if there's a texture budget
+		// the sprites are the ones left to be loaded on demand.
+		TArray<FPrecacheItem> items;
 		for (int i = cnt - 1; i >= 0; i--)
 		{
 			FTexture *tex = TexMan.ByIndex(i);
-			if (tex != nullptr)
+			if (tex != nullptr && (texhitlist[i] & (FTextureManager::HIT_Wall | FTextureManager::HIT_Flat | FTextureManager::HIT_Sky)))
 			{
-				PrecacheTexture(tex, texhitlist[i]);
-				if (spritehitlist[i] != nullptr && (*spritehitlist[i]).CountUsed() > 0)
-				{
-					PrecacheSprite(tex, *spritehitlist[i]);
-				}
+				items.Push({ tex, nullptr });
+			}
+		}
+		for (int i = cnt - 1; i >= 0; i--)
+		{
+			FTexture *tex = TexMan.ByIndex(i);
+			if (tex != nullptr && spritehitlist[i] != nullptr && (*spritehitlist[i]).CountUsed() > 0)
+			{
+				items.Push({ tex, spritehitlist[i] });
 			}
 		}
+		for (unsigned i = 0; i < items.Size() && !OverBudget(); i += PRECACHE_BATCH)
+		{
+			PrecacheBatch(&items[i], MIN<unsigned>(PRECACHE_BATCH, items.Size() - i));
+		}
 
 
 		FImageSource::EndPrecaching();
@@ -278,3 +368,50 @@ void hw_PrecacheTexture(uint8_t *texhitlist, TMap<PClassActor*, bool> &actorhitl
 	delete[] modellist;
 }
 
+//==========================================================================
+//
+// Runs every texture through the upscaler so that the results end up in
+// the disk cache and don't need to be created during gameplay. Nothing
+// gets uploaded, so this works on the entire resource set regardless of
+// what the current level uses.
+//
+//==========================================================================
+
+CCMD(warmhqcache)
+{
+	if (gl_texture_hqresizemode == 0 || gl_texture_hqresizemult < 2 || !gl_texture_hqresize_cache)
+	{
+		Printf("Texture upscaling or its cache is disabled.\n");
+		return;
+	}
+
+	cycle_t time;
+	time.Reset();
+	time.Clock();
+
+	TArray<FTexBufferRequest> requests;
+	int count = 0;
+	auto flush = [&]()
+	{
+		count += requests.Size();
+		FTexture::PrepareTexBuffers(requests);
+		FTexture::ReleasePreparedTexBuffers();
+		requests.Clear();
+	};
+
+	for (int i = 0; i < TexMan.NumTextures(); i++)
+	{
+		FTexture *tex = TexMan.ByIndex(i);
+		if (tex == nullptr || tex->GetImage() == nullptr) continue;
+
+		// Sprites are always created with a border, so they get the same buffers as during precaching.
+		auto type = tex->GetUseType();
+		FMaterial *mat = FMaterial::ValidateTexture(tex, type == ETextureType::Sprite || type == ETextureType::SkinSprite);
+		if (mat != nullptr) AddTexBufferRequest(requests, mat, 0);
+		if (requests.Size() >= PRECACHE_BATCH) flush();
+	}
+	flush();
+
+	time.Unclock();
+	Printf("Processed %d textures in %.2f s\n", count, time.TimeMS() / 1000);
+}
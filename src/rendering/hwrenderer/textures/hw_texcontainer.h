@@ -99,6 +99,25 @@ public:
 		tt->hwTexture =tex;
 	}
 
+	//===========================================================================
+	// 
+	// Deletes a single hardware texture. Used when evicting textures
+	// that exceed the texture memory budget.
+	//
+	//===========================================================================
+
+	void DeleteHardwareTexture(IHardwareTexture *tex)
+	{
+		for (auto & t : hwDefTex)
+		{
+			if (t.hwTexture == tex) t.Delete();
+		}
+		for (int i = hwTex_Translated.Size() - 1; i >= 0; i--)
+		{
+			if (hwTex_Translated[i].hwTexture == tex) hwTex_Translated.Delete(i);
+		}
+	}
+
 	//===========================================================================
 	// 
 	// Deletes all allocated resources and considers translations
@@ -56,6 +56,8 @@ int vertexcount, flatvertices, flatprimitives;
 
 int rendered_lines,rendered_flats,rendered_sprites,render_vertexsplit,render_texsplit,rendered_decals, rendered_portals, rendered_commandbuffers;
 int iter_dlightf, iter_dlight, draw_dlight, draw_dlightf;
+int render_statechanges, render_sortgroups;
+int clipper_checks, clipper_binrejects;
 
 void ResetProfilingData()
 {
@@ -79,6 +81,8 @@ void ResetProfilingData()
 
 	flatvertices=flatprimitives=vertexcount=0;
 	render_texsplit=render_vertexsplit=rendered_lines=rendered_flats=rendered_sprites=rendered_decals=rendered_portals = 0;
+	render_statechanges = render_sortgroups = 0;
+	clipper_checks = clipper_binrejects = 0;
 }
 
 //-----------------------------------------------------------------------------
@@ -93,14 +97,14 @@ static void AppendRenderTimes(FString &str)
 	double clipwall = ClipWall.TimeMS();
 	double bsp = Bsp.TimeMS() - ClipWall.TimeMS();
 
-	str.AppendFormat("BSP = %2.3f, Clip=%2.3f\n"
+	str.AppendFormat("BSP = %2.3f, Clip=%2.3f (%d range checks, %d rejected by coverage bins)\n"
 		"W: Render=%2.3f, Setup=%2.3f\n"
 		"F: Render=%2.3f, Setup=%2.3f\n"
 		"S: Render=%2.3f, Setup=%2.3f\n"
 		"2D: %2.3f Finish3D: %2.3f\n"
 		"Main thread total=%2.3f, Main thread waiting=%2.3f Worker thread total=%2.3f, Worker thread waiting=%2.3f\n"
 		"All=%2.3f, Render=%2.3f, Setup=%2.3f, Portal=%2.3f, Drawcalls=%2.3f, Postprocess=%2.3f, Finish=%2.3f\n",
-		bsp, clipwall,
+		bsp, clipwall, clipper_checks, clipper_binrejects,
 		RenderWall.TimeMS(), setupwall, 
 		RenderFlat.TimeMS(), SetupFlat.TimeMS(),
 		RenderSprite.TimeMS(), SetupSprite.TimeMS(), 
@@ -113,8 +117,10 @@ static void AppendRenderStats(FString &out)
 {
 	out.AppendFormat("Walls: %d (%d splits, %d t-splits, %d vertices)\n"
 		"Flats: %d (%d primitives, %d vertices)\n"
-		"Sprites: %d, Decals=%d, Portals: %d, Command buffers: %d\n",
-		rendered_lines, render_vertexsplit, render_texsplit, vertexcount, rendered_flats, flatprimitives, flatvertices, rendered_sprites,rendered_decals, rendered_portals, rendered_commandbuffers );
+		"Sprites: %d, Decals=%d, Portals: %d, Command buffers: %d\n"
+		"Opaque state changes: %d, Translucent sort groups: %d\n",
+		rendered_lines, render_vertexsplit, render_texsplit, vertexcount, rendered_flats, flatprimitives, flatvertices, rendered_sprites,rendered_decals, rendered_portals, rendered_commandbuffers,
+		render_statechanges, render_sortgroups);
 }
 
 static void AppendLightStats(FString &out)
@@ -18,6 +18,8 @@ extern glcycle_t MTWait, WTTotal;
 extern int iter_dlightf, iter_dlight, draw_dlight, draw_dlightf;
 extern int rendered_lines,rendered_flats,rendered_sprites,rendered_decals,render_vertexsplit,render_texsplit;
 extern int rendered_portals;
+extern int render_statechanges, render_sortgroups;
+extern int clipper_checks, clipper_binrejects;
 
 extern int vertexcount, flatvertices, flatprimitives;
 
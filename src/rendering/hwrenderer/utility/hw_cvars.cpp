@@ -37,6 +37,7 @@ CVAR(Bool, gl_noquery, false, 0)
 CVAR(Bool,gl_mirrors,true,0)	// This is for debugging only!
 CVAR(Bool,gl_mirror_envmap, true, CVAR_GLOBALCONFIG|CVAR_ARCHIVE)
 CVAR(Bool, gl_seamless, false, CVAR_ARCHIVE|CVAR_GLOBALCONFIG)
+CVAR(Bool, gl_staticwalls, true, CVAR_ARCHIVE|CVAR_GLOBALCONFIG)	// keep wall vertices in a static part of the vertex buffer
 
 CUSTOM_CVAR(Int, r_mirror_recursions,4,CVAR_GLOBALCONFIG|CVAR_ARCHIVE)
 {
@@ -87,6 +88,16 @@ CUSTOM_CVAR(Bool, gl_texture_usehires, true, CVAR_ARCHIVE|CVAR_NOINITCALL)
 
 CVAR(Bool, gl_precache, false, CVAR_ARCHIVE)
 
+// Upper limit for texture memory in megabytes. 0 means unlimited.
+CUSTOM_CVAR(Int, gl_texture_budget, 0, CVAR_ARCHIVE|CVAR_GLOBALCONFIG)
+{
+	if (self < 0) self = 0;
+}
+
+// Upload textures with a hires replacement or upscaling from their original image first
+// and replace them once the full version is ready. See FTexture::UpdateStreaming.
+CVAR(Bool, gl_texture_streaming, false, CVAR_ARCHIVE|CVAR_GLOBALCONFIG)
+
 //==========================================================================
 //
 // Sprite CVARs
@@ -11,6 +11,8 @@ EXTERN_CVAR(Int, gl_texture_filter)
 EXTERN_CVAR(Float, gl_texture_filter_anisotropic)
 EXTERN_CVAR(Int, gl_texture_format)
 EXTERN_CVAR(Bool, gl_texture_usehires)
+EXTERN_CVAR(Int, gl_texture_budget)
+EXTERN_CVAR(Bool, gl_texture_streaming)
 EXTERN_CVAR(Bool, gl_usefb)
 
 EXTERN_CVAR(Int, gl_weaponlight)
@@ -27,6 +29,7 @@ EXTERN_CVAR(Bool,gl_mirror_envmap)
 EXTERN_CVAR(Bool,gl_mirrors)
 EXTERN_CVAR(Bool,gl_mirror_envmap)
 EXTERN_CVAR(Bool, gl_seamless)
+EXTERN_CVAR(Bool, gl_staticwalls)
 
 EXTERN_CVAR(Float, gl_mask_threshold)
 EXTERN_CVAR(Float, gl_mask_sprite_threshold)
@@ -120,6 +120,7 @@ void Draw2D(F2DDrawer *drawer, FRenderState &state, bool outside2D)
 
 	if (drawer->mIsFirstPass)
 	{
+		drawer->MergeCommands();
 		for (auto &v : vertices)
 		{
 			// Change from BGRA to RGBA
@@ -167,7 +167,38 @@ void PolyTriangleThreadData::DrawElements(const PolyDrawArgs &drawargs, const vo
 	args.uniforms = &drawargs;
 
 	ShadedTriVertex vert[3];
-	if (drawmode == PolyDrawMode::Triangles)
+	if (drawmode == PolyDrawMode::Triangles && modelFrame1 != -1)
+	{
+		// Model meshes share most vertices between several triangles.
+		// Shade each of them only once per draw and reuse the result.
+		if (++shadedGeneration == 0)
+		{
+			for (auto &stamp : shadedStamps) stamp = 0;
+			shadedGeneration = 1;
+		}
+		for (int i = 0; i < vcount / 3; i++)
+		{
+			for (int j = 0; j < 3; j++)
+			{
+				unsigned int index = *(elements++);
+				if (index >= shadedStamps.Size())
+				{
+					unsigned int oldsize = shadedStamps.Size();
+					shadedStamps.Resize(index + 1);
+					shadedVertices.Resize(index + 1);
+					for (unsigned int k = oldsize; k <= index; k++) shadedStamps[k] = 0;
+				}
+				if (shadedStamps[index] != shadedGeneration)
+				{
+					shadedVertices[index] = ShadeVertex(drawargs, vertices, index);
+					shadedStamps[index] = shadedGeneration;
+				}
+				vert[j] = shadedVertices[index];
+			}
+			DrawShadedTriangle(vert, ccw, &args);
+		}
+	}
+	else if (drawmode == PolyDrawMode::Triangles)
 	{
 		for (int i = 0; i < vcount / 3; i++)
 		{
@@ -128,6 +128,11 @@ private:
 	int modelFrame2 = -1;
 	float modelInterpolationFactor = 0.0f;
 
+	// Shaded vertices of the current indexed model draw. See DrawElements.
+	TArray<ShadedTriVertex> shadedVertices;
+	TArray<uint32_t> shadedStamps;
+	uint32_t shadedGeneration = 0;
+
 	enum { max_additional_vertices = 16 };
 };
 
@@ -702,6 +702,12 @@ void VulkanFrameBuffer::StartPrecaching()
 	VkHardwareTexture::ResetAllDescriptors();
 }
 
+void VulkanFrameBuffer::ResetTextureBindings()
+{
+	// Some of the existing descriptors may reference layer textures that just got deleted.
+	VkHardwareTexture::ResetAllDescriptors();
+}
+
 void VulkanFrameBuffer::BlurScene(float amount)
 {
 	if (mPostprocess)
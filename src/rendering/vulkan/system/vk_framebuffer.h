@@ -82,6 +82,7 @@ public:
 	void SetTextureFilterMode() override;
 	void TextureFilterChanged() override;
 	void StartPrecaching() override;
+	void ResetTextureBindings() override;
 	void BeginFrame() override;
 	void BlurScene(float amount) override;
 	void PostProcessScene(int fixedcm, const std::function<void()> &afterBloomDrawEndScene2D) override;
@@ -215,6 +215,7 @@ void VkHardwareTexture::CreateImage(FTexture *tex, int translation, int flags)
 
 		FTextureBuffer texbuffer = tex->CreateTexBuffer(translation, flags | CTF_ProcessData);
 		CreateTexture(texbuffer.mWidth, texbuffer.mHeight, 4, VK_FORMAT_B8G8R8A8_UNORM, texbuffer.mBuffer);
+		SetMemoryUsage(texbuffer.mWidth, texbuffer.mHeight, true);
 	}
 	else
 	{
@@ -478,6 +478,9 @@ private:
 };
 
 int VMCall(VMFunction *func, VMValue *params, int numparams, VMReturn *results, int numresults/*, VMException **trap = NULL*/);
+// Counts the calls into script functions. Scripts can write to anything they can see,
+// so data that was cached from the game state is stale once this has changed.
+extern unsigned VMScriptCallCount;
 int VMCallWithDefaults(VMFunction *func, TArray<VMValue> &params, VMReturn *results, int numresults/*, VMException **trap = NULL*/);
 
 inline int VMCallAction(VMFunction *func, VMValue *params, int numparams, VMReturn *results, int numresults/*, VMException **trap = NULL*/)
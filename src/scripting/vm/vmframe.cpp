@@ -58,6 +58,7 @@ void JitRelease() {}
 
 cycle_t VMCycles[10];
 int VMCalls[10];
+unsigned VMScriptCallCount;
 
 #if 0
 IMPLEMENT_CLASS(VMException, false, false)
@@ -564,6 +565,7 @@ int VMCall(VMFunction *func, VMValue *params, int numparams, VMReturn *results,
 			else
 			{
 				VMCycles[0].Clock();
+				VMScriptCallCount++;
 
 				auto sfunc = static_cast<VMScriptFunction *>(func);
 				int numret = sfunc->ScriptCall(sfunc, params, numparams, results, numresults);
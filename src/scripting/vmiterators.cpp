@@ -342,7 +342,7 @@ class DActorIterator : public DObject, public NActorIterator
 	DECLARE_ABSTRACT_CLASS(DActorIterator, DObject)
 
 public:
-	DActorIterator(AActor **hash, PClassActor *cls = nullptr, int tid = 0)
+	DActorIterator(FTIDHash &hash, PClassActor *cls = nullptr, int tid = 0)
 		: NActorIterator(hash, cls, tid)
 	{
 	}
@@ -140,6 +140,371 @@ struct FJSONObject
 	}
 };
 
+//==========================================================================
+//
+// Binary savegame format
+//
+// This is a token stream which maps 1:1 onto the JSON events so that
+// the reader can rebuild the exact same document the JSON parser would
+// produce. Keys are only stored as text the first time they are used,
+// afterward they are referenced by index. Numbers are stored as varints
+// or raw IEEE doubles, so no formatting or parsing of text is involved.
+//
+// The output is passed through the deflater in chunks while it is being
+// written so that the uncompressed data never needs to be held in memory
+// as a whole.
+//
+//==========================================================================
+
+static const char BinaryMagic[4] = { 'G', 'Z', 'S', 'B' };
+enum
+{
+	BINSAVE_VERSION = 1,
+
+	BIN_NULL = 0,
+	BIN_FALSE,
+	BIN_TRUE,
+	BIN_INT,			// zigzag encoded varint
+	BIN_UINT,			// varint
+	BIN_DOUBLE,			// 8 bytes, little endian
+	BIN_STRING,			// varint length + data
+	BIN_STARTOBJECT,
+	BIN_ENDOBJECT,
+	BIN_STARTARRAY,
+	BIN_ENDARRAY,
+	BIN_KEY,			// varint index into the key table
+	BIN_NEWKEY,			// varint length + data, gets appended to the key table
+};
+
+static inline unsigned HashKey(const char *key, size_t len)
+{
+	unsigned hash = 2166136261u;
+	for (size_t i = 0; i < len; i++)
+	{
+		hash = (hash ^ (uint8_t)key[i]) * 16777619u;
+	}
+	return hash;
+}
+
+struct FBinaryWriter
+{
+	enum
+	{
+		FLUSH_SIZE = 0x40000,
+	};
+
+	TArray<uint8_t> mBuffer;		// not yet compressed data
+	TArray<uint8_t> mCompressed;
+	TArray<FString> mKeys;
+	TArray<int> mKeyHash;
+	z_stream mStream;
+	unsigned mTotalSize = 0;
+	uint32_t mCRC32 = 0;
+	bool mError = false;
+
+	FBinaryWriter()
+	{
+		memset(&mStream, 0, sizeof(mStream));
+		// create output in zip-compatible form as required by FCompressedBuffer
+		mError = deflateInit2(&mStream, 8, Z_DEFLATED, -15, 9, Z_DEFAULT_STRATEGY) != Z_OK;
+		mKeyHash.Resize(1024);
+		for (auto &h : mKeyHash) h = -1;
+		mBuffer.Grow(FLUSH_SIZE + 256);
+		for (auto c : BinaryMagic) mBuffer.Push(c);
+		mBuffer.Push(BINSAVE_VERSION);
+	}
+
+	~FBinaryWriter()
+	{
+		deflateEnd(&mStream);
+	}
+
+	void Flush(bool finish)
+	{
+		if (mError) return;
+		mCRC32 = crc32(mCRC32, mBuffer.Data(), mBuffer.Size());
+		mTotalSize += mBuffer.Size();
+		mStream.next_in = mBuffer.Data();
+		mStream.avail_in = mBuffer.Size();
+		int err;
+		do
+		{
+			if (mCompressed.Size() - mStream.total_out < 0x10000)
+			{
+				mCompressed.Resize(mCompressed.Size() + MAX<unsigned>(0x10000, mCompressed.Size() / 2));
+			}
+			mStream.next_out = mCompressed.Data() + mStream.total_out;
+			mStream.avail_out = mCompressed.Size() - (unsigned)mStream.total_out;
+			err = deflate(&mStream, finish ? Z_FINISH : Z_NO_FLUSH);
+			if (err != Z_OK && err != Z_STREAM_END)
+			{
+				mError = true;
+				break;
+			}
+		} while (mStream.avail_out == 0 || (finish && err != Z_STREAM_END));
+		mBuffer.Clear();
+	}
+
+	FCompressedBuffer Finish()
+	{
+		FCompressedBuffer buff = { 0, 0, METHOD_DEFLATE, 0, 0, nullptr };
+		Flush(true);
+		if (!mError)
+		{
+			buff.mSize = mTotalSize;
+			buff.mCompressedSize = (unsigned)mStream.total_out;
+			buff.mCRC32 = mCRC32;
+			buff.mBuffer = new char[buff.mCompressedSize];
+			memcpy(buff.mBuffer, mCompressed.Data(), buff.mCompressedSize);
+		}
+		return buff;
+	}
+
+	void Byte(uint8_t b)
+	{
+		mBuffer.Push(b);
+	}
+
+	void Varint(uint64_t v)
+	{
+		while (v >= 0x80)
+		{
+			mBuffer.Push(uint8_t(v | 0x80));
+			v >>= 7;
+		}
+		mBuffer.Push(uint8_t(v));
+	}
+
+	void Data(const char *data, size_t len)
+	{
+		Varint(len);
+		if (len > 0)
+		{
+			unsigned pos = mBuffer.Reserve(len);
+			memcpy(&mBuffer[pos], data, len);
+		}
+	}
+
+	void Token(uint8_t tok)
+	{
+		if (mBuffer.Size() >= FLUSH_SIZE) Flush(false);
+		mBuffer.Push(tok);
+	}
+
+	void StartObject() { Token(BIN_STARTOBJECT); }
+	void EndObject() { Token(BIN_ENDOBJECT); }
+	void StartArray() { Token(BIN_STARTARRAY); }
+	void EndArray() { Token(BIN_ENDARRAY); }
+	void Null() { Token(BIN_NULL); }
+	void Bool(bool k) { Token(k ? BIN_TRUE : BIN_FALSE); }
+
+	void Int64(int64_t k)
+	{
+		Token(BIN_INT);
+		Varint((uint64_t(k) << 1) ^ uint64_t(k >> 63));
+	}
+
+	void Uint64(uint64_t k)
+	{
+		Token(BIN_UINT);
+		Varint(k);
+	}
+
+	void Double(double k)
+	{
+		uint64_t bits;
+		memcpy(&bits, &k, 8);
+		Token(BIN_DOUBLE);
+		for (int i = 0; i < 8; i++, bits >>= 8) mBuffer.Push(uint8_t(bits));
+	}
+
+	void String(const char *k)
+	{
+		Token(BIN_STRING);
+		Data(k, strlen(k));
+	}
+
+	void Key(const char *k)
+	{
+		size_t len = strlen(k);
+		unsigned mask = mKeyHash.Size() - 1;
+		unsigned slot = HashKey(k, len) & mask;
+		while (mKeyHash[slot] >= 0)
+		{
+			auto &key = mKeys[mKeyHash[slot]];
+			if (key.Len() == len && !memcmp(key.GetChars(), k, len))
+			{
+				Token(BIN_KEY);
+				Varint(mKeyHash[slot]);
+				return;
+			}
+			slot = (slot + 1) & mask;
+		}
+		mKeyHash[slot] = mKeys.Push(FString(k, len));
+		Token(BIN_NEWKEY);
+		Data(k, len);
+
+		if (mKeys.Size() * 2 > mKeyHash.Size())
+		{
+			// rehash.
+			mKeyHash.Resize(mKeyHash.Size() * 2);
+			for (auto &h : mKeyHash) h = -1;
+			mask = mKeyHash.Size() - 1;
+			for (unsigned i = 0; i < mKeys.Size(); i++)
+			{
+				slot = HashKey(mKeys[i].GetChars(), mKeys[i].Len()) & mask;
+				while (mKeyHash[slot] >= 0) slot = (slot + 1) & mask;
+				mKeyHash[slot] = i;
+			}
+		}
+	}
+};
+
+//==========================================================================
+//
+// Generator for rapidjson::Document::Populate which feeds
+// the binary token stream into the document.
+//
+//==========================================================================
+
+struct FBinaryReader
+{
+	struct KeyRef
+	{
+		const char *str;
+		unsigned len;
+	};
+
+	const uint8_t *p, *end;
+	TArray<KeyRef> mKeys;
+	TArray<unsigned> mCounts;
+
+	FBinaryReader(const char *buffer, size_t length)
+	{
+		p = (const uint8_t*)buffer + sizeof(BinaryMagic) + 1;
+		end = (const uint8_t*)buffer + length;
+	}
+
+	static bool IsBinary(const char *buffer, size_t length)
+	{
+		return length > sizeof(BinaryMagic) && !memcmp(buffer, BinaryMagic, sizeof(BinaryMagic)) && buffer[sizeof(BinaryMagic)] == BINSAVE_VERSION;
+	}
+
+	bool Varint(uint64_t &v)
+	{
+		v = 0;
+		for (int shift = 0; shift < 64 && p < end; shift += 7)
+		{
+			uint8_t b = *p++;
+			v |= uint64_t(b & 0x7f) << shift;
+			if (!(b & 0x80)) return true;
+		}
+		return false;
+	}
+
+	bool Data(const uint8_t *&data, uint64_t &len)
+	{
+		if (!Varint(len) || len > uint64_t(end - p)) return false;
+		data = p;
+		p += len;
+		return true;
+	}
+
+	bool operator()(rapidjson::Document &doc)
+	{
+		uint64_t v;
+		const uint8_t *data;
+
+		while (p < end)
+		{
+			switch (*p++)
+			{
+			case BIN_NULL:
+				doc.Null();
+				break;
+
+			case BIN_FALSE:
+				doc.Bool(false);
+				break;
+
+			case BIN_TRUE:
+				doc.Bool(true);
+				break;
+
+			case BIN_INT:
+				if (!Varint(v)) return false;
+				doc.Int64(int64_t(v >> 1) ^ -int64_t(v & 1));
+				break;
+
+			case BIN_UINT:
+				if (!Varint(v)) return false;
+				doc.Uint64(v);
+				break;
+
+			case BIN_DOUBLE:
+			{
+				if (end - p < 8) return false;
+				uint64_t bits = 0;
+				for (int i = 7; i >= 0; i--) bits = (bits << 8) | p[i];
+				p += 8;
+				double d;
+				memcpy(&d, &bits, 8);
+				doc.Double(d);
+				break;
+			}
+
+			case BIN_STRING:
+				if (!Data(data, v)) return false;
+				doc.String((const char*)data, (rapidjson::SizeType)v, true);
+				break;
+
+			case BIN_STARTOBJECT:
+				doc.StartObject();
+				mCounts.Push(0);
+				continue;
+
+			case BIN_STARTARRAY:
+				doc.StartArray();
+				mCounts.Push(0);
+				continue;
+
+			case BIN_ENDOBJECT:
+				if (mCounts.Size() == 0) return false;
+				doc.EndObject(mCounts.Last());
+				mCounts.Pop();
+				break;
+
+			case BIN_ENDARRAY:
+				if (mCounts.Size() == 0) return false;
+				doc.EndArray(mCounts.Last());
+				mCounts.Pop();
+				break;
+
+			case BIN_NEWKEY:
+				if (!Data(data, v)) return false;
+				mKeys.Push({ (const char*)data, (unsigned)v });
+				doc.Key((const char*)data, (rapidjson::SizeType)v, true);
+				continue;
+
+			case BIN_KEY:
+			{
+				if (!Varint(v) || v >= mKeys.Size()) return false;
+				auto &key = mKeys[(unsigned)v];
+				doc.Key(key.str, key.len, true);
+				continue;
+			}
+
+			default:
+				return false;
+			}
+			// a value has been completed.
+			if (mCounts.Size() == 0) return p == end;
+			mCounts.Last()++;
+		}
+		return false;
+	}
+};
+
 //==========================================================================
 //
 // some wrapper stuff to keep the RapidJSON dependencies out of the global headers.
@@ -152,23 +517,26 @@ struct FWriter
 	typedef rapidjson::Writer<rapidjson::StringBuffer, rapidjson::UTF8<> > Writer;
 	typedef rapidjson::PrettyWriter<rapidjson::StringBuffer, rapidjson::UTF8<> > PrettyWriter;
 
-	Writer *mWriter1;
-	PrettyWriter *mWriter2;
+	Writer *mWriter1 = nullptr;
+	PrettyWriter *mWriter2 = nullptr;
+	FBinaryWriter *mWriter3 = nullptr;
 	TArray<bool> mInObject;
 	rapidjson::StringBuffer mOutString;
 	TArray<DObject *> mDObjects;
 	TMap<DObject *, int> mObjectMap;
 	
-	FWriter(bool pretty)
+	FWriter(bool pretty, bool binary = false)
 	{
-		if (!pretty)
+		if (binary)
+		{
+			mWriter3 = new FBinaryWriter;
+		}
+		else if (!pretty)
 		{
 			mWriter1 = new Writer(mOutString);
-			mWriter2 = nullptr;
 		}
 		else
 		{
-			mWriter1 = nullptr;
 			mWriter2 = new PrettyWriter(mOutString);
 		}
 	}
@@ -177,6 +545,7 @@ struct FWriter
 	{
 		if (mWriter1) delete mWriter1;
 		if (mWriter2) delete mWriter2;
+		if (mWriter3) delete mWriter3;
 	}
 
 
@@ -189,36 +558,42 @@ struct FWriter
 	{
 		if (mWriter1) mWriter1->StartObject();
 		else if (mWriter2) mWriter2->StartObject();
+		else if (mWriter3) mWriter3->StartObject();
 	}
 
 	void EndObject()
 	{
 		if (mWriter1) mWriter1->EndObject();
 		else if (mWriter2) mWriter2->EndObject();
+		else if (mWriter3) mWriter3->EndObject();
 	}
 
 	void StartArray()
 	{
 		if (mWriter1) mWriter1->StartArray();
 		else if (mWriter2) mWriter2->StartArray();
+		else if (mWriter3) mWriter3->StartArray();
 	}
 
 	void EndArray()
 	{
 		if (mWriter1) mWriter1->EndArray();
 		else if (mWriter2) mWriter2->EndArray();
+		else if (mWriter3) mWriter3->EndArray();
 	}
 
 	void Key(const char *k)
 	{
 		if (mWriter1) mWriter1->Key(k);
 		else if (mWriter2) mWriter2->Key(k);
+		else if (mWriter3) mWriter3->Key(k);
 	}
 
 	void Null()
 	{
 		if (mWriter1) mWriter1->Null();
 		else if (mWriter2) mWriter2->Null();
+		else if (mWriter3) mWriter3->Null();
 	}
 
 	void StringU(const char *k, bool encode)
@@ -226,6 +601,7 @@ struct FWriter
 		if (encode) k = StringToUnicode(k);
 		if (mWriter1) mWriter1->String(k);
 		else if (mWriter2) mWriter2->String(k);
+		else if (mWriter3) mWriter3->String(k);
 	}
 
 	void String(const char *k)
@@ -233,6 +609,7 @@ struct FWriter
 		k = StringToUnicode(k);
 		if (mWriter1) mWriter1->String(k);
 		else if (mWriter2) mWriter2->String(k);
+		else if (mWriter3) mWriter3->String(k);
 	}
 
 	void String(const char *k, int size)
@@ -240,36 +617,42 @@ struct FWriter
 		k = StringToUnicode(k, size);
 		if (mWriter1) mWriter1->String(k);
 		else if (mWriter2) mWriter2->String(k);
+		else if (mWriter3) mWriter3->String(k);
 	}
 
 	void Bool(bool k)
 	{
 		if (mWriter1) mWriter1->Bool(k);
 		else if (mWriter2) mWriter2->Bool(k);
+		else if (mWriter3) mWriter3->Bool(k);
 	}
 
 	void Int(int32_t k)
 	{
 		if (mWriter1) mWriter1->Int(k);
 		else if (mWriter2) mWriter2->Int(k);
+		else if (mWriter3) mWriter3->Int64(k);
 	}
 
 	void Int64(int64_t k)
 	{
 		if (mWriter1) mWriter1->Int64(k);
 		else if (mWriter2) mWriter2->Int64(k);
+		else if (mWriter3) mWriter3->Int64(k);
 	}
 
 	void Uint(uint32_t k)
 	{
 		if (mWriter1) mWriter1->Uint(k);
 		else if (mWriter2) mWriter2->Uint(k);
+		else if (mWriter3) mWriter3->Uint64(k);
 	}
 
 	void Uint64(int64_t k)
 	{
 		if (mWriter1) mWriter1->Uint64(k);
 		else if (mWriter2) mWriter2->Uint64(k);
+		else if (mWriter3) mWriter3->Uint64(k);
 	}
 
 	void Double(double k)
@@ -282,6 +665,10 @@ struct FWriter
 		{
 			mWriter2->Double(k);
 		}
+		else if (mWriter3)
+		{
+			mWriter3->Double(k);
+		}
 	}
 
 };
@@ -303,8 +690,15 @@ struct FReader
 
 	FReader(const char *buffer, size_t length)
 	{
-		rapidjson::Document doc;
-		mDoc.Parse(buffer, length);
+		if (FBinaryReader::IsBinary(buffer, length))
+		{
+			FBinaryReader reader(buffer, length);
+			mDoc.Populate(reader);
+		}
+		else
+		{
+			mDoc.Parse(buffer, length);
+		}
 		mObjects.Push(FJSONObject(&mDoc));
 		memset(mPlayers, -1, sizeof(mPlayers));
 	}
@@ -355,6 +749,23 @@ bool FSerializer::OpenWriter(bool pretty)
 	return true;
 }
 
+//==========================================================================
+//
+// Opens a writer for the binary format. Its output can only be
+// retrieved with GetCompressedOutput.
+//
+//==========================================================================
+
+bool FSerializer::OpenBinaryWriter()
+{
+	if (w != nullptr || r != nullptr) return false;
+
+	mErrors = 0;
+	w = new FWriter(false, true);
+	BeginObject(nullptr);
+	return true;
+}
+
 //==========================================================================
 //
 //
@@ -1027,7 +1438,7 @@ void FSerializer::ReadObjects(bool hubtravel)
 
 const char *FSerializer::GetOutput(unsigned *len)
 {
-	if (isReading()) return nullptr;
+	if (isReading() || w->mWriter3 != nullptr) return nullptr;
 	WriteObjects();
 	EndObject();
 	if (len != nullptr)
@@ -1043,58 +1454,28 @@ const char *FSerializer::GetOutput(unsigned *len)
 //
 //==========================================================================
 
-FCompressedBuffer FSerializer::GetCompressedOutput()
+FCompressedBuffer FSerializer::GetCompressedOutput(bool compress)
 {
 	if (isReading()) return{ 0,0,0,0,0,nullptr };
 	FCompressedBuffer buff;
 	WriteObjects();
 	EndObject();
-	buff.mSize = (unsigned)w->mOutString.GetSize();
-	buff.mZipFlags = 0;
-	buff.mCRC32 = crc32(0, (const Bytef*)w->mOutString.GetString(), buff.mSize);
-
-	uint8_t *compressbuf = new uint8_t[buff.mSize+1];
-
-	z_stream stream;
-	int err;
-
-	stream.next_in = (Bytef *)w->mOutString.GetString();
-	stream.avail_in = buff.mSize;
-	stream.next_out = (Bytef*)compressbuf;
-	stream.avail_out = buff.mSize;
-	stream.zalloc = (alloc_func)0;
-	stream.zfree = (free_func)0;
-	stream.opaque = (voidpf)0;
-
-	// create output in zip-compatible form as required by FCompressedBuffer
-	err = deflateInit2(&stream, 8, Z_DEFLATED, -15, 9, Z_DEFAULT_STRATEGY);
-	if (err != Z_OK)
+	if (w->mWriter3 != nullptr)
 	{
-		goto error;
-	}
-
-	err = deflate(&stream, Z_FINISH);
-	if (err != Z_STREAM_END) 
-	{
-		deflateEnd(&stream);
-		goto error;
-	}
-	buff.mCompressedSize = stream.total_out;
-
-	err = deflateEnd(&stream);
-	if (err == Z_OK)
-	{
-		buff.mBuffer = new char[buff.mCompressedSize];
-		buff.mMethod = METHOD_DEFLATE;
-		memcpy(buff.mBuffer, compressbuf, buff.mCompressedSize);
-		delete[] compressbuf;
+		buff = w->mWriter3->Finish();
+		if (buff.mBuffer == nullptr)
+		{
+			I_Error("Failed to compress savegame data");
+		}
 		return buff;
 	}
-
-error:
-	memcpy(compressbuf, w->mOutString.GetString(), buff.mSize + 1);
-	buff.mCompressedSize = buff.mSize;
+	buff.mSize = buff.mCompressedSize = (unsigned)w->mOutString.GetSize();
 	buff.mMethod = METHOD_STORED;
+	buff.mZipFlags = 0;
+	buff.mCRC32 = crc32(0, (const Bytef*)w->mOutString.GetString(), buff.mSize);
+	buff.mBuffer = new char[buff.mSize + 1];
+	memcpy(buff.mBuffer, w->mOutString.GetString(), buff.mSize + 1);
+	if (compress) buff.Compress();
 	return buff;
 }
 
@@ -83,6 +83,7 @@ public:
 		Close();
 	}
 	bool OpenWriter(bool pretty = true);
+	bool OpenBinaryWriter();
 	bool OpenReader(const char *buffer, size_t length);
 	bool OpenReader(FCompressedBuffer *input);
 	void Close();
@@ -93,8 +94,8 @@ public:
 	void EndArray();
 	unsigned GetSize(const char *group);
 	const char *GetKey();
-	const char *GetOutput(unsigned *len = nullptr);
-	FCompressedBuffer GetCompressedOutput();
+	const char *GetOutput(unsigned *len = nullptr);	// only for JSON output.
+	FCompressedBuffer GetCompressedOutput(bool compress = true);	// binary output is always compressed.
 	FSerializer &Args(const char *key, int *args, int *defargs, int special);
 	FSerializer &Terrain(const char *key, int &terrain, int *def = nullptr);
 	FSerializer &Sprite(const char *key, int32_t &spritenum, int32_t *def);
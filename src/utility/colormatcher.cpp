@@ -36,12 +36,19 @@
 ** revisiting the problem. I never did, so now it's relegated to the mists
 ** of SVN history, and this is just a thin wrapper around BestColor().
 **
+** It now splits RGB space into cells and precomputes which palette entries
+** can possibly be the closest match for anything inside a cell, so Pick
+** only needs to check a handful of colors but still returns exactly the
+** same index as BestColor().
+**
 */
 
 #include <stdlib.h>
+#include <limits.h>
 
 #include "doomtype.h"
 #include "colormatcher.h"
+#include "templates.h"
 #include "v_palette.h"
 
 FColorMatcher::FColorMatcher ()
@@ -62,12 +69,82 @@ FColorMatcher::FColorMatcher (const FColorMatcher &other)
 FColorMatcher &FColorMatcher::operator= (const FColorMatcher &other)
 {
 	Pal = other.Pal;
+	CellStart = other.CellStart;
+	Candidates = other.Candidates;
 	return *this;
 }
 
 void FColorMatcher::SetPalette (const uint32_t *palette)
 {
 	Pal = (const PalEntry *)palette;
+	BuildCells ();
+}
+
+//==========================================================================
+//
+// FColorMatcher :: BuildCells
+//
+// For every cell, a palette entry is a candidate if its closest distance
+// to the cell is not larger than the farthest distance of the best entry.
+// Any color that is further away cannot win for any point in the cell.
+// This also keeps all entries that tie with the winner, and since they are
+// stored in ascending order the lowest index wins just like in BestColor.
+//
+// The palette is not supposed to change after being set. If it does,
+// SetPalette must be called again.
+//
+//==========================================================================
+
+void FColorMatcher::BuildCells ()
+{
+	CellStart.Clear();
+	Candidates.Clear();
+	if (Pal == NULL) return;
+
+	const int cellsize = 1 << CELL_SHIFT;
+	int mindist[256];
+
+	CellStart.Resize(CELL_COUNT * CELL_COUNT * CELL_COUNT + 1);
+	Candidates.Reserve(CELL_COUNT * CELL_COUNT * CELL_COUNT * 16);
+	Candidates.Clear();
+
+	int cell = 0;
+	for (int r = 0; r < CELL_COUNT; r++)
+	{
+		for (int g = 0; g < CELL_COUNT; g++)
+		{
+			for (int b = 0; b < CELL_COUNT; b++)
+			{
+				int lo[3] = { r * cellsize, g * cellsize, b * cellsize };
+				int threshold = INT_MAX;
+
+				// Same range as BestColor's defaults.
+				for (int color = 1; color < 255; color++)
+				{
+					int c[3] = { Pal[color].r, Pal[color].g, Pal[color].b };
+					int nearest = 0, farthest = 0;
+					for (int i = 0; i < 3; i++)
+					{
+						int hi = lo[i] + cellsize - 1;
+						int d = c[i] < lo[i] ? lo[i] - c[i] : c[i] > hi ? c[i] - hi : 0;
+						int f = MAX(abs(c[i] - lo[i]), abs(c[i] - hi));
+						nearest += d * d;
+						farthest += f * f;
+					}
+					mindist[color] = nearest;
+					threshold = MIN(threshold, farthest);
+				}
+
+				CellStart[cell++] = Candidates.Size();
+				for (int color = 1; color < 255; color++)
+				{
+					if (mindist[color] <= threshold) Candidates.Push(color);
+				}
+			}
+		}
+	}
+	CellStart[cell] = Candidates.Size();
+	Candidates.ShrinkToFit();
 }
 
 uint8_t FColorMatcher::Pick (int r, int g, int b)
@@ -75,5 +152,32 @@ uint8_t FColorMatcher::Pick (int r, int g, int b)
 	if (Pal == NULL)
 		return 1;
 
-	return (uint8_t)BestColor ((uint32_t *)Pal, r, g, b);
+	if ((unsigned)r > 255 || (unsigned)g > 255 || (unsigned)b > 255 || CellStart.Size() == 0)
+	{
+		return (uint8_t)BestColor ((uint32_t *)Pal, r, g, b);
+	}
+
+	int cell = (((r >> CELL_SHIFT) * CELL_COUNT) + (g >> CELL_SHIFT)) * CELL_COUNT + (b >> CELL_SHIFT);
+	const uint8_t *cand = &Candidates[CellStart[cell]];
+	const uint8_t *end = Candidates.Data() + CellStart[cell + 1];
+	int bestcolor = *cand;
+	int bestdist = INT_MAX;
+
+	for (; cand < end; cand++)
+	{
+		const PalEntry &pe = Pal[*cand];
+		int x = r - pe.r;
+		int y = g - pe.g;
+		int z = b - pe.b;
+		int dist = x*x + y*y + z*z;
+		if (dist < bestdist)
+		{
+			if (dist == 0)
+				return *cand;
+
+			bestdist = dist;
+			bestcolor = *cand;
+		}
+	}
+	return (uint8_t)bestcolor;
 }
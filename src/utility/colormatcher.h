@@ -34,6 +34,8 @@
 #ifndef __COLORMATCHER_H__
 #define __COLORMATCHER_H__
 
+#include "tarray.h"
+
 class FColorMatcher
 {
 public:
@@ -51,7 +53,17 @@ public:
 	FColorMatcher &operator= (const FColorMatcher &other);
 
 private:
+	enum
+	{
+		CELL_SHIFT = 4,					// each cell covers 16x16x16 RGB values
+		CELL_COUNT = 256 >> CELL_SHIFT,
+	};
+
+	void BuildCells ();
+
 	const PalEntry *Pal;
+	TArray<uint32_t> CellStart;		// CELL_COUNT^3 + 1 offsets into Candidates
+	TArray<uint8_t> Candidates;		// palette indices that can be the closest match for some color in the cell
 };
 
 extern FColorMatcher ColorMatcher;
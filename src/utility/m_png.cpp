@@ -36,6 +36,9 @@
 
 #include <stdlib.h>
 #include <zlib.h>
+#ifndef NO_SSE
+#include <emmintrin.h>
+#endif
 #ifdef _MSC_VER
 #include <malloc.h>		// for alloca()
 #endif
@@ -1049,6 +1052,124 @@ static bool WriteIDAT (FileWriter *file, const uint8_t *data, int len)
 	return true;
 }
 
+#ifndef NO_SSE
+
+//==========================================================================
+//
+// SSE2 versions of the filters for 24 and 32 bit pixels.
+//
+// Sub, Average and Paeth depend on the pixel to the left, so they can't
+// process more than one pixel at once, but they can do all channels of
+// a pixel in one go. Only Up works on full vectors.
+//
+//==========================================================================
+
+// Loads and stores always access 4 bytes, except for the last pixel of a 24 bit row.
+// The extra byte belongs to the next pixel, which gets written afterward anyway.
+template<int bpp> static inline __m128i LoadPixel(const uint8_t *p, bool last)
+{
+	uint32_t v = 0;
+	if (bpp == 4 || !last) memcpy(&v, p, 4);
+	else memcpy(&v, p, 3);
+	return _mm_cvtsi32_si128(v);
+}
+
+template<int bpp> static inline void StorePixel(uint8_t *p, __m128i v, bool last)
+{
+	uint32_t c = _mm_cvtsi128_si32(v);
+	if (bpp == 4 || !last) memcpy(p, &c, 4);
+	else memcpy(p, &c, 3);
+}
+
+static void UnfilterUp_SSE2(int width, uint8_t *dest, const uint8_t *row, const uint8_t *prev)
+{
+	for (; width >= 16; width -= 16, dest += 16, row += 16, prev += 16)
+	{
+		__m128i v = _mm_add_epi8(_mm_loadu_si128((const __m128i *)row), _mm_loadu_si128((const __m128i *)prev));
+		_mm_storeu_si128((__m128i *)dest, v);
+	}
+	for (; width > 0; --width)
+	{
+		*dest++ = *row++ + *prev++;
+	}
+}
+
+template<int bpp> static void UnfilterSub_SSE2(int width, uint8_t *dest, const uint8_t *row)
+{
+	__m128i a = _mm_setzero_si128();
+	for (; width > 0; width -= bpp, dest += bpp, row += bpp)
+	{
+		bool last = width == bpp;
+		a = _mm_add_epi8(a, LoadPixel<bpp>(row, last));
+		StorePixel<bpp>(dest, a, last);
+	}
+}
+
+template<int bpp> static void UnfilterAverage_SSE2(int width, uint8_t *dest, const uint8_t *row, const uint8_t *prev)
+{
+	const __m128i one = _mm_set1_epi8(1);
+	__m128i a = _mm_setzero_si128();
+	for (; width > 0; width -= bpp, dest += bpp, row += bpp, prev += bpp)
+	{
+		bool last = width == bpp;
+		__m128i b = LoadPixel<bpp>(prev, last);
+		// _mm_avg_epu8 rounds up but the filter needs to round down.
+		__m128i avg = _mm_sub_epi8(_mm_avg_epu8(a, b), _mm_and_si128(_mm_xor_si128(a, b), one));
+		a = _mm_add_epi8(avg, LoadPixel<bpp>(row, last));
+		StorePixel<bpp>(dest, a, last);
+	}
+}
+
+static inline __m128i Abs16_SSE2(__m128i x)
+{
+	return _mm_max_epi16(x, _mm_sub_epi16(_mm_setzero_si128(), x));
+}
+
+static inline __m128i Select_SSE2(__m128i cond, __m128i t, __m128i e)
+{
+	return _mm_or_si128(_mm_and_si128(cond, t), _mm_andnot_si128(cond, e));
+}
+
+template<int bpp> static void UnfilterPaeth_SSE2(int width, uint8_t *dest, const uint8_t *row, const uint8_t *prev)
+{
+	const __m128i zero = _mm_setzero_si128();
+	// a, b and c are kept as 16 bit values so that the predictor can be calculated without overflow.
+	__m128i a = zero, c = zero;
+	for (; width > 0; width -= bpp, dest += bpp, row += bpp, prev += bpp)
+	{
+		bool last = width == bpp;
+		__m128i b = _mm_unpacklo_epi8(LoadPixel<bpp>(prev, last), zero);
+		__m128i pa = _mm_sub_epi16(b, c);
+		__m128i pb = _mm_sub_epi16(a, c);
+		__m128i pc = Abs16_SSE2(_mm_add_epi16(pa, pb));
+		pa = Abs16_SSE2(pa);
+		pb = Abs16_SSE2(pb);
+
+		// Same priority as the scalar version: a, then b, then c.
+		__m128i smallest = _mm_min_epi16(pc, _mm_min_epi16(pa, pb));
+		__m128i pred = Select_SSE2(_mm_cmpeq_epi16(pa, smallest), a, Select_SSE2(_mm_cmpeq_epi16(pb, smallest), b, c));
+
+		__m128i d = _mm_add_epi8(_mm_packus_epi16(pred, pred), LoadPixel<bpp>(row, last));
+		StorePixel<bpp>(dest, d, last);
+		a = _mm_unpacklo_epi8(d, zero);
+		c = b;
+	}
+}
+
+template<int bpp> static bool UnfilterRow_SSE2(int filter, int width, uint8_t *dest, const uint8_t *row, const uint8_t *prev)
+{
+	switch (filter)
+	{
+	case 1:		UnfilterSub_SSE2<bpp>(width, dest, row);				return true;
+	case 2:		UnfilterUp_SSE2(width, dest, row, prev);				return true;
+	case 3:		UnfilterAverage_SSE2<bpp>(width, dest, row, prev);		return true;
+	case 4:		UnfilterPaeth_SSE2<bpp>(width, dest, row, prev);		return true;
+	default:	return false;
+	}
+}
+
+#endif
+
 //==========================================================================
 //
 // UnfilterRow
@@ -1063,6 +1184,17 @@ void UnfilterRow (int width, uint8_t *dest, uint8_t *row, uint8_t *prev, int bpp
 {
 	int x;
 
+#ifndef NO_SSE
+	// For 24 and 32 bit pixels width is always a multiple of bpp.
+	if (bpp == 4 && UnfilterRow_SSE2<4>(*row, width, dest, row + 1, prev)) return;
+	if (bpp == 3 && UnfilterRow_SSE2<3>(*row, width, dest, row + 1, prev)) return;
+	if (*row == 2)
+	{
+		UnfilterUp_SSE2(width, dest, row + 1, prev);
+		return;
+	}
+#endif
+
 	switch (*row++)
 	{
 	case 1:		// Sub
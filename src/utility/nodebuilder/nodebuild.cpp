@@ -43,11 +43,16 @@
 
 #include "doomdata.h"
 #include "nodebuild.h"
+#include "parallel_for.h"
 
 const int MaxSegs = 64;
 const int SplitCost = 8;
 const int AAPreference = 16;
 
+// Scoring the splitter candidates of a set is spread over several threads
+// once it needs at least this many segs classified in total.
+const unsigned ParallelSplitterWork = 1 << 16;
+
 #if 0
 #define D(x) x
 #else
@@ -86,6 +91,65 @@ FNodeBuilder::~FNodeBuilder()
 	}
 }
 
+FNodeBuildTask::FNodeBuildTask (FNodeBuilder::FLevel &lev,
+								TArray<FNodeBuilder::FPolyStart> &polyspots, TArray<FNodeBuilder::FPolyStart> &anchors,
+								bool makeGLNodes)
+	: Done(false), Builder(NULL)
+{
+	Thread = std::thread([=, &lev, &polyspots, &anchors]()
+	{
+		try
+		{
+			Builder = new FNodeBuilder (lev, polyspots, anchors, makeGLNodes);
+		}
+		catch (...)
+		{
+			Error = std::current_exception();
+		}
+		Done = true;
+	});
+}
+
+FNodeBuildTask::~FNodeBuildTask ()
+{
+	if (Thread.joinable())
+	{
+		Thread.join();
+	}
+	if (Builder != NULL)
+	{
+		delete Builder;
+	}
+}
+
+// Returns the finished builder. Errors thrown by the build are passed on
+// to the caller from here.
+
+FNodeBuilder &FNodeBuildTask::Wait ()
+{
+	if (Thread.joinable())
+	{
+		Thread.join();
+	}
+	if (Error)
+	{
+		std::exception_ptr error = Error;
+		Error = NULL;
+		std::rethrow_exception (error);
+	}
+	Builder->PrintMessages();
+	return *Builder;
+}
+
+void FNodeBuilder::PrintMessages()
+{
+	for (auto &message : Messages)
+	{
+		Printf ("%s", message.GetChars());
+	}
+	Messages.Clear();
+}
+
 void FNodeBuilder::BuildMini(bool makeGLNodes)
 {
 	GLNodes = makeGLNodes;
@@ -428,7 +492,7 @@ bool FNodeBuilder::ShoveSegBehind (uint32_t set, node_t &node, uint32_t seg, uin
 		node.dx = -node.dx;
 		node.dy = -node.dy;
 	}
-	return Heuristic (node, set, false) > 0;
+	return Heuristic (node, set, false, Touched, Colinear) > 0;
 }
 
 // Splitters are chosen to coincide with segs in the given set. To reduce the
@@ -449,6 +513,8 @@ int FNodeBuilder::SelectSplitter (uint32_t set, node_t &node, uint32_t &splitseg
 	bestvalue = 0;
 	bestseg = UINT_MAX;
 
+	unsigned int setsize = 0;
+
 	seg = set;
 	stepleft = 0;
 
@@ -456,6 +522,8 @@ int FNodeBuilder::SelectSplitter (uint32_t set, node_t &node, uint32_t &splitseg
 
 	D(Printf (PRINT_LOG, "Processing set %d\n", set));
 
+	// First pick the segs to try. Only one seg of each plane needs to be checked.
+	Candidates.Clear ();
 	while (seg != UINT_MAX)
 	{
 		FPrivSeg *pseg = &Segs[seg];
@@ -473,26 +541,58 @@ int FNodeBuilder::SelectSplitter (uint32_t set, node_t &node, uint32_t &splitseg
 				}
 
 				stepleft = step;
-				SetNodeFromSeg (node, pseg);
+				Candidates.Push (seg);
+			}
+		}
 
-				int value = Heuristic (node, set, nosplit);
+		setsize++;
+		seg = pseg->next;
+	}
 
-				D(Printf (PRINT_LOG, "Seg %5d, ld %d (%5d,%5d)-(%5d,%5d) scores %d\n", seg, Segs[seg].linedef, node.x>>16, node.y>>16,
-					(node.x+node.dx)>>16, (node.y+node.dy)>>16, value));
+	// Scoring a candidate does not change anything in the builder, so for
+	// big sets they can all be scored at once.
+	unsigned int numcandidates = Candidates.Size ();
+	Scores.Resize (numcandidates);
+	if (numcandidates > 1 && numcandidates * setsize >= ParallelSplitterWork)
+	{
+		parallel_for (int(numcandidates), [&](int i)
+		{
+			static thread_local TArray<int> touched, colinear;
 
-				if (value > bestvalue)
-				{
-					bestvalue = value;
-					bestseg = seg;
-				}
-				else if (value < 0)
-				{
-					nosplitters = true;
-				}
+			if (unsigned(i) < numcandidates)
+			{
+				node_t testnode;
+				SetNodeFromSeg (testnode, &Segs[Candidates[i]]);
+				Scores[i] = Heuristic (testnode, set, nosplit, touched, colinear);
 			}
+		});
+	}
+	else
+	{
+		for (unsigned int i = 0; i < numcandidates; ++i)
+		{
+			SetNodeFromSeg (node, &Segs[Candidates[i]]);
+			Scores[i] = Heuristic (node, set, nosplit, Touched, Colinear);
 		}
+	}
 
-		seg = pseg->next;
+	// Then pick the best one, in the same order they would have been tried one by one.
+	for (unsigned int i = 0; i < numcandidates; ++i)
+	{
+		int value = Scores[i];
+
+		seg = Candidates[i];
+		D(Printf (PRINT_LOG, "Seg %5d, ld %d scores %d\n", seg, Segs[seg].linedef, value));
+
+		if (value > bestvalue)
+		{
+			bestvalue = value;
+			bestseg = seg;
+		}
+		else if (value < 0)
+		{
+			nosplitters = true;
+		}
 	}
 
 	if (bestseg == UINT_MAX)
@@ -514,7 +614,7 @@ int FNodeBuilder::SelectSplitter (uint32_t set, node_t &node, uint32_t &splitseg
 // true. A score of 0 means that the splitter does not split any of the segs
 // in the set.
 
-int FNodeBuilder::Heuristic (node_t &node, uint32_t set, bool honorNoSplit)
+int FNodeBuilder::Heuristic (node_t &node, uint32_t set, bool honorNoSplit, TArray<int> &touched, TArray<int> &colinear)
 {
 	// Set the initial score above 0 so that near vertex anti-weighting is less likely to produce a negative score.
 	int score = 1000000;
@@ -529,8 +629,8 @@ int FNodeBuilder::Heuristic (node_t &node, uint32_t set, bool honorNoSplit)
 	unsigned int max, m2, p, q;
 	double frac;
 
-	Touched.Clear ();
-	Colinear.Clear ();
+	touched.Clear ();
+	colinear.Clear ();
 
 	while (i != UINT_MAX)
 	{
@@ -556,32 +656,32 @@ int FNodeBuilder::Heuristic (node_t &node, uint32_t set, bool honorNoSplit)
 			{
 				if ((sidev[0] | sidev[1]) != 0)
 				{
-					max = Touched.Size();
+					max = touched.Size();
 					for (p = 0; p < max; ++p)
 					{
-						if (Touched[p] == test->loopnum)
+						if (touched[p] == test->loopnum)
 						{
 							break;
 						}
 					}
 					if (p == max)
 					{
-						Touched.Push (test->loopnum);
+						touched.Push (test->loopnum);
 					}
 				}
 				else
 				{
-					max = Colinear.Size();
+					max = colinear.Size();
 					for (p = 0; p < max; ++p)
 					{
-						if (Colinear[p] == test->loopnum)
+						if (colinear[p] == test->loopnum)
 						{
 							break;
 						}
 					}
 					if (p == max)
 					{
-						Colinear.Push (test->loopnum);
+						colinear.Push (test->loopnum);
 					}
 				}
 			}
@@ -698,8 +798,8 @@ int FNodeBuilder::Heuristic (node_t &node, uint32_t set, bool honorNoSplit)
 	// seg of that sector must be crossing the container's corner and does not
 	// actually split the container.
 
-	max = Touched.Size ();
-	m2 = Colinear.Size ();
+	max = touched.Size ();
+	m2 = colinear.Size ();
 
 	// If honorNoSplit is false, then both these lists will be empty.
 
@@ -712,10 +812,10 @@ int FNodeBuilder::Heuristic (node_t &node, uint32_t set, bool honorNoSplit)
 
 	for (p = 0; p < max; ++p)
 	{
-		int look = Touched[p];
+		int look = touched[p];
 		for (q = 0; q < m2; ++q)
 		{
-			if (look == Colinear[q])
+			if (look == colinear[q])
 			{
 				break;
 			}
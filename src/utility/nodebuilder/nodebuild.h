@@ -36,6 +36,9 @@
 */
 #pragma once
 
+#include <thread>
+#include <atomic>
+#include <exception>
 #include "doomdata.h"
 #include "tarray.h"
 #include "r_defs.h"
@@ -236,6 +239,7 @@ public:
 
 	void Extract(FLevelLocals &lev);
 	const int *GetOldVertexTable();
+	void PrintMessages();
 
 	// These are used for building sub-BSP trees for polyobjects.
 	void Clear();
@@ -267,6 +271,8 @@ private:
 
 	TArray<int> Touched;	// Loops a splitter touches on a vertex
 	TArray<int> Colinear;	// Loops with edges colinear to a splitter
+	TArray<uint32_t> Candidates;	// Segs SelectSplitter wants scored
+	TArray<int> Scores;		// Their scores
 	FEventTree Events;		// Vertices intersected by the current splitter
 
 	TArray<FSplitSharer> SplitSharers;	// Segs colinear with the current splitter
@@ -279,6 +285,10 @@ private:
 	// Progress meter stuff
 	int SegsStuffed;
 
+	// Warnings about the map. They get printed by PrintMessages, because
+	// the builder may run on another thread than the console.
+	TArray<FString> Messages;
+
 	void FindUsedVertices (vertex_t *vertices, int max);
 	void BuildTree ();
 	void MakeSegsFromSides ();
@@ -297,7 +307,7 @@ private:
 	bool ShoveSegBehind (uint32_t set, node_t &node, uint32_t seg, uint32_t mate);	int SelectSplitter (uint32_t set, node_t &node, uint32_t &splitseg, int step, bool nosplit);
 	void SplitSegs (uint32_t set, node_t &node, uint32_t splitseg, uint32_t &outset0, uint32_t &outset1, unsigned int &count0, unsigned int &count1);
 	uint32_t SplitSeg (uint32_t segnum, int splitvert, int v1InFront);
-	int Heuristic (node_t &node, uint32_t set, bool honorNoSplit);
+	int Heuristic (node_t &node, uint32_t set, bool honorNoSplit, TArray<int> &touched, TArray<int> &colinear);
 
 	// Returns:
 	//	0 = seg is in front
@@ -330,6 +340,28 @@ private:
 	FNodeBuilder &operator= (const FNodeBuilder &) { return *this; }
 };
 
+// Builds the nodes for a level on a separate thread so that the caller can
+// do something else in the meantime. The level data and polyobject spots
+// must not be touched until Wait has returned.
+
+class FNodeBuildTask
+{
+public:
+	FNodeBuildTask (FNodeBuilder::FLevel &lev,
+		TArray<FNodeBuilder::FPolyStart> &polyspots, TArray<FNodeBuilder::FPolyStart> &anchors,
+		bool makeGLNodes);
+	~FNodeBuildTask ();
+
+	bool IsDone () const { return Done; }
+	FNodeBuilder &Wait ();
+
+private:
+	std::thread Thread;
+	std::atomic<bool> Done;
+	std::exception_ptr Error;
+	FNodeBuilder *Builder;
+};
+
 // Points within this distance of a line will be considered on the line.
 // Units are in fixed_ts.
 const double SIDE_EPSILON = 6.5536;
@@ -132,7 +132,7 @@ void FNodeBuilder::MakeSegsFromSides ()
 		}
 		else
 		{
-			Printf ("Linedef %d does not have a front side.\n", i);
+			Messages.Push(FStringf("Linedef %d does not have a front side.\n", i));
 		}
 
 		if (Level.Lines[i].sidedef[1] != NULL)
@@ -441,6 +441,7 @@ public:
 	virtual void BeginFrame() {}
 	virtual void SetWindowSize(int w, int h) {}
 	virtual void StartPrecaching() {}
+	virtual void ResetTextureBindings() {}
 
 	virtual int GetClientWidth() = 0;
 	virtual int GetClientHeight() = 0;
@@ -496,6 +497,8 @@ public:
 
 	virtual void Draw2D(bool outside2D = false) {}
 	void Clear2D() { m2DDrawer.Clear(); }
+	bool BeginDisplayList(F2DDrawer::FDisplayList &list, std::initializer_list<intptr_t> key) { return m2DDrawer.BeginDisplayList(list, key); }
+	void EndDisplayList(F2DDrawer::FDisplayList &list) { m2DDrawer.EndDisplayList(list); }
 
 	// Dim part of the canvas
 	void Dim(PalEntry color, float amount, int x1, int y1, int w, int h, FRenderStyle *style = nullptr);